@@ -0,0 +1,52 @@
+#include QMK_KEYBOARD_H
+
+#include "usb_device_state.h"
+
+#include "boot_stage.h"
+#include "keymap_user.h"
+#include "report_coalesce.h"
+#include "timing.h"
+
+// Postupná inicializace: keyboard_post_init_user připraví jen to, co potřebuje psaní,
+// a první snímek OLED se pošle z hlavní smyčky, až je USB nakonfigurované. Haptiku
+// inicializuje jádro QMK v keyboard_init ještě před keyboard_post_init_user a druhé
+// haptic_init by jen znovu četlo EEPROM a nastavovalo pin, takže se tu neodkládá.
+
+static boot_stage_t stage = BOOT_STAGE_HID;
+static boot_stats_t stats;
+
+void boot_stage_task(void) {
+    if (stats.first_report_us == 0 && report_coalesce_stats()->reports_sent) {
+        stats.first_report_us = report_coalesce_stats()->first_report_us;
+        dprintf("boot: first report %lu us\n", stats.first_report_us);
+    }
+
+    switch (stage) {
+        case BOOT_STAGE_HID:
+            if (usb_device_state == USB_DEVICE_STATE_CONFIGURED || timer_read32() >= BOOT_DEFER_MAX_MS) {
+                stats.hid_ready_us = timing_us();
+                dprintf("boot: HID ready %lu us\n", stats.hid_ready_us);
+                stage = BOOT_STAGE_OLED;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void boot_stage_oled_frame_done(void) {
+    if (stage != BOOT_STAGE_OLED) return;
+
+    stats.first_oled_frame_us = timing_us();
+    dprintf("boot: first OLED frame %lu us\n", stats.first_oled_frame_us);
+    stage = BOOT_STAGE_READY;
+}
+
+bool boot_stage_reached(boot_stage_t target) {
+    return stage >= target;
+}
+
+const boot_stats_t *boot_stage_stats(void) {
+    return &stats;
+}
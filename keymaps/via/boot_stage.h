@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef BOOT_DEFER_MAX_MS
+#    define BOOT_DEFER_MAX_MS 1500 // bez USB hostitele (jen napájení) se displej zapne po této době
+#endif
+
+typedef enum {
+    BOOT_STAGE_HID,    // běží jen matice, USB a haptika (inicializuje ji jádro v keyboard_init), čeká se na enumeraci
+    BOOT_STAGE_OLED,   // první snímek displeje
+    BOOT_STAGE_READY,
+} boot_stage_t;
+
+typedef struct {
+    uint32_t hid_ready_us;        // reset -> USB nakonfigurované, pad může posílat reporty
+    uint32_t first_report_us;     // reset -> první skutečně odeslaný report (po prvním stisku)
+    uint32_t first_oled_frame_us; // reset -> první snímek odeslaný na displej
+} boot_stats_t;
+
+void boot_stage_task(void);
+void boot_stage_oled_frame_done(void); // volá oled_task_user po prvním vykresleném snímku
+
+bool boot_stage_reached(boot_stage_t stage);
+
+const boot_stats_t *boot_stage_stats(void);
@@ -0,0 +1,207 @@
+#include QMK_KEYBOARD_H
+
+#include "chord_engine.h"
+#include "key_index.h"
+#include "event_bus.h"
+#include "ram_watch.h"
+
+// Chordy jsou uložené jako seřazené 16bitové masky kláves. Při každé události se
+// pracuje jen s maskou aktuálně držených kláves: dvě bitmapy přes všech 2^11 masek
+// řeknou, jestli maska ještě může být chordem, a binární hledání najde přesnou shodu.
+// Cena rozhodnutí tak nezávisí na počtu chordů. Tabulky obsahují jen chordy aktivní
+// vrstvy a staví se znovu při EVENT_LAYER_CHANGED; na vrstvě bez chordů projdou
+// klávesy bez zdržení.
+
+#define MASK_SPACE (1 << KEY_COUNT)
+
+static uint16_t chord_masks[CHORD_MAX];
+static uint16_t chord_keycodes[CHORD_MAX];
+static uint8_t  chord_total = 0;
+static uint16_t chord_union = 0; // klávesy, které jsou součástí nějakého chordu
+
+static uint8_t candidate_bits[MASK_SPACE / 8]; // maska je podmnožinou nějakého chordu
+static uint8_t extends_bits[MASK_SPACE / 8];   // maska je vlastní podmnožinou nějakého chordu
+RAM_ACCOUNT(sizeof(chord_masks) + sizeof(chord_keycodes) + sizeof(candidate_bits) + sizeof(extends_bits), CHORD_RAM);
+
+static keyevent_t buffered[KEY_COUNT]; // zadržené stisky čekající na rozhodnutí
+static uint8_t    buffered_count = 0;
+static uint16_t   active_mask    = 0;
+static uint16_t   window_start   = 0;
+
+static uint16_t fired_mask    = 0; // klávesy odpálených chordů, jejichž puštění pohltíme
+static uint16_t chord_held    = 0; // klávesy chordu, který drží fired_keycode
+static uint16_t fired_keycode = KC_NO;
+
+static bool replaying = false;
+
+static inline bool mask_bit(const uint8_t *bits, uint16_t mask) {
+    return bits[mask >> 3] & (1 << (mask & 7));
+}
+
+static inline void set_mask_bit(uint8_t *bits, uint16_t mask) {
+    bits[mask >> 3] |= 1 << (mask & 7);
+}
+
+static uint16_t chord_lookup(uint16_t mask) {
+    uint8_t lo = 0, hi = chord_total;
+
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+
+        if (chord_masks[mid] == mask) return chord_keycodes[mid];
+        if (chord_masks[mid] < mask) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return KC_NO;
+}
+
+static void build(uint8_t layer) {
+    chord_total = 0;
+    chord_union = 0;
+    memset(candidate_bits, 0, sizeof(candidate_bits));
+    memset(extends_bits, 0, sizeof(extends_bits));
+
+    for (uint16_t i = 0; i < chord_count && chord_total < CHORD_MAX; i++) {
+        uint16_t mask    = pgm_read_word(&chords[i].mask) & (MASK_SPACE - 1);
+        uint16_t keycode = pgm_read_word(&chords[i].keycode);
+
+        if (!(pgm_read_byte(&chords[i].layers) & CHORD_LAYER(layer))) continue;
+        if (mask == 0 || chord_lookup(mask) != KC_NO) continue; // prázdné a duplicitní přeskočíme
+
+        // vložení na místo, pole zůstává seřazené
+        uint8_t pos = chord_total;
+        while (pos > 0 && chord_masks[pos - 1] > mask) {
+            chord_masks[pos]    = chord_masks[pos - 1];
+            chord_keycodes[pos] = chord_keycodes[pos - 1];
+            pos--;
+        }
+        chord_masks[pos]    = mask;
+        chord_keycodes[pos] = keycode;
+        chord_total++;
+        chord_union |= mask;
+
+        for (uint16_t sub = mask; sub; sub = (sub - 1) & mask) {
+            set_mask_bit(candidate_bits, sub);
+            if (sub != mask) set_mask_bit(extends_bits, sub);
+        }
+    }
+}
+
+static void fire(uint16_t keycode) {
+    if (fired_keycode != KC_NO) { // drží se jen jeden chord, nový ukončí předchozí
+        unregister_code16(fired_keycode);
+    }
+    fired_mask |= active_mask; // puštění kláves předchozího chordu se dál pohlcují
+    chord_held     = active_mask;
+    fired_keycode  = keycode;
+    active_mask    = 0;
+    buffered_count = 0;
+    register_code16(keycode);
+}
+
+// zadržené stisky nejsou chord, pustíme je do QMK v původním pořadí
+static void replay(void) {
+    uint8_t count  = buffered_count;
+    active_mask    = 0;
+    buffered_count = 0;
+
+    replaying = true;
+    for (uint8_t i = 0; i < count; i++) {
+        action_exec(buffered[i]);
+    }
+    replaying = false;
+}
+
+bool chord_replaying(void) {
+    return replaying;
+}
+
+// rozhodne zadržené stisky: přesná shoda = chord, jinak normální klávesy
+static void resolve(void) {
+    if (active_mask == 0) return;
+
+    uint16_t keycode = chord_lookup(active_mask);
+    if (keycode != KC_NO) {
+        fire(keycode);
+    } else {
+        replay();
+    }
+}
+
+static void on_layer_changed(const event_t *event) {
+    resolve(); // zadržené stisky se rozhodnou podle tabulek vrstvy, ve které vznikly
+    build(get_highest_layer(event->new_value));
+}
+
+void chord_init(void) {
+    build(get_highest_layer(layer_state));
+    if (!event_subscribe(EVENT_LAYER_CHANGED, on_layer_changed)) { // tabulky by zůstaly pro startovní vrstvu
+        dprintf("chord: no layer subscription, chords stay on layer %u\n", get_highest_layer(layer_state));
+    }
+}
+
+static void release_fired(uint16_t bit) {
+    if ((chord_held & bit) && fired_keycode != KC_NO) {
+        unregister_code16(fired_keycode);
+        fired_keycode = KC_NO;
+    }
+    chord_held &= ~bit;
+    fired_mask &= ~bit;
+}
+
+bool process_chord(uint16_t keycode, keyrecord_t *record) {
+    if (replaying || (chord_total == 0 && fired_mask == 0)) return true; // vrstva bez chordů, nic nedržíme
+
+    int8_t index = key_index(record->event.key);
+    if (index < 0) return true;
+
+    uint16_t bit = CHORD_KEY(index);
+
+    if (record->event.pressed) {
+        if (!(chord_union & bit)) {
+            resolve();
+            return true;
+        }
+
+        uint16_t next = active_mask | bit;
+        if (!mask_bit(candidate_bits, next)) {
+            resolve();
+            next = bit;
+        }
+
+        if (active_mask == 0) window_start = record->event.time;
+        buffered[buffered_count++] = record->event;
+        active_mask                = next;
+
+        // žádný delší chord už nepřichází v úvahu, není na co čekat
+        if (!mask_bit(extends_bits, active_mask)) {
+            resolve();
+        }
+        return false;
+    }
+
+    if (fired_mask & bit) {
+        release_fired(bit);
+        return false;
+    }
+
+    if (active_mask & bit) {
+        resolve();
+
+        // chord se odpálil a hned končí puštěním této klávesy
+        if (fired_mask & bit) {
+            release_fired(bit);
+            return false;
+        }
+    }
+    return true;
+}
+
+void chord_task(void) {
+    if (active_mask && timer_elapsed(window_start) >= CHORD_TERM) {
+        resolve();
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "key_index.h"
+
+#ifndef CHORD_TERM
+#    define CHORD_TERM 40 // okno v ms, během kterého musí být stisknuty všechny klávesy chordu
+#endif
+
+#ifndef CHORD_MAX
+#    define CHORD_MAX 64 // maximální počet chordů (RAM: 4 B na chord + 512 B bitmapy)
+#endif
+
+#define CHORD_RAM (CHORD_MAX * 4 + 2 * (1 << KEY_COUNT) / 8) // seřazené masky a keycody + dvě bitmapy masek
+
+#define CHORD_KEY(i) ((uint16_t)1 << (i)) // bit klávesy podle pořadí v LAYOUT_martin_3x3
+#define CHORD_LAYER(n) ((uint8_t)1 << (n)) // vrstva, na které chord platí (nejvyšší aktivní)
+
+typedef struct {
+    uint16_t mask;    // maska kláves, viz CHORD_KEY()
+    uint16_t keycode; // základní keycode (i s modifikátory), který chord pošle
+    uint8_t  layers;  // maska vrstev, viz CHORD_LAYER()
+} chord_t;
+
+// definuje keymap.c
+extern const chord_t  chords[];
+extern const uint16_t chord_count;
+
+void chord_init(void); // tabulky pro aktuální vrstvu, při každé změně vrstvy se postaví znovu
+bool process_chord(uint16_t keycode, keyrecord_t *record); // false = událost pohlcena
+void chord_task(void);
+bool chord_replaying(void); // true během action_exec zadržených stisků, ty už svůj čas mají
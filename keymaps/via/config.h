@@ -12,9 +12,15 @@
 #define I2C0_SDA_PIN I2C_SDA_PIN
 
 #define OLED_FADE_OUT 2000 // Trvání vyblednutí OLED v ms
-#define OLED_TIMEOUT 20000 // Vypnutí OLED po nečinnosti v ms
+#define OLED_TIMEOUT 600000 // Vypnutí OLED po nečinnosti v ms, předtím ho šetří oled_saver
 #define OLED_BRIGHTNESS 255 // Jas OLED (0-255)
 
+#define OLED_I2C_FAST_HZ 1000000 // I2C pro displej: Fast-mode Plus
+#define OLED_I2C_SAFE_HZ 400000 // záložní rychlost po chybách na sběrnici
+#define OLED_I2C_TIMEOUT_MS 5 // timeout jednoho přenosu (stránka = 129 B)
+#define OLED_I2C_FALLBACK_ERRORS 2 // chyby po sobě před zpomalením a obnovou sběrnice
+#define OLED_I2C_RETRY_FAST_MS 60000 // po minutě bez chyby zkusit znovu rychlý profil
+
 #define BOOTMAGIC_ROW 0 // Řádek pro Bootmagic (tlačítko v levém horním rohu)
 #define BOOTMAGIC_COLUMN 0 // Sloupec pro Bootmagic (tlačítko v levém horním rohu)
 
@@ -38,4 +44,57 @@
 
 #define DYNAMIC_KEYMAP_LAYER_COUNT 4 // Počet vrstev pro dynamickou klávesnici
 
+#define EECONFIG_USER_DATA_SIZE 8 // user_settings_t: časování a orientace displeje z VIA
+
+#define FORCE_NKRO // NKRO report hned po startu místo 6KRO boot reportu
+#define USB_POLLING_INTERVAL_MS 1 // dotazování USB hostem každou 1 ms (1 kHz)
+#define REPORT_STATS_WINDOW_MS 1000 // okno pro měření reportů za sekundu
+
+#define CHORD_TERM 40 // okno pro současný stisk kláves chordu v ms
+#define CHORD_MAX 64 // maximální počet chordů
+
+#define USER_FLASH_OFFSET 0x1C0000 // uživatelská oblast ve flash (makra), pod wear-leveling EEPROM
+#define USER_FLASH_SIZE 0x30000 // velikost uživatelské oblasti (192 kB)
+#define PROFILE_COUNT 4 // profil 0 = keymapa VIA, 1-3 = banky ve flash (PROFILE_FLASH_SIZE stačí na 7)
+#define MACRO_RING_EVENTS 256 // RAM buffer nahrávání makra v událostech
+#define MACRO_SPILL_IDLE_MS 150 // zápis makra do flash až po této době bez stisku
+
+#define TURBO_MAX_ACTIVE 4 // držených kláves s opakováním najednou (+2 deferred exec pro KC_CYCLE_LAYERS, QMK jich má 8)
+
+#define IDLE_TIMEOUT 20000 // po vypnutí OLED nebo ve spořiči se matice neskenuje a čeká se na přerušení
+#define IDLE_MAX_SLEEP_MS USB_POLLING_INTERVAL_MS // nejdelší spánek ve WFI mezi dvěma průchody smyčkou, raw HID čeká nejvýš jeden interval USB
+
+#define MATRIX_SAMPLER_HZ 4000 // MATRIX_SAMPLER = yes: vzorkování matice z přerušení (Hz)
+#define MATRIX_SAMPLER_DEBOUNCE 5 // debounce ve vzorcích přerušení, odpovídá 5 ms
+#ifdef MATRIX_SAMPLER
+#define DEBOUNCE 0 // debounce QMK v hlavní smyčce se nepoužije, dělá ho vzorkovač
+#endif
+
+#define BOOT_DEFER_MAX_MS 1500 // haptika a OLED nejpozději po této době, i bez USB hostitele
+
+#define OLED_ANIM_FRAMES 8 // počet snímků přechodu mezi vrstvami
+#define OLED_ANIM_BUDGET_US 4000 // nejvíc µs, které animace přidá jednomu průchodu smyčkou
+#define OLED_ANIM_MAX_PAGES 2 // nejvíc stránek složených a odeslaných na jeden průchod
+#define OLED_SAVER_DIM_MS 10000 // spořič: po této nečinnosti klesne kontrast (jen příkazy SSD1306)
+#define OLED_SAVER_CONTRAST 16 // kontrast ve spořiči
+#define OLED_SAVER_ORBIT_MS 60000 // posun obrazu o pixel offsetem displeje
+#define OLED_SAVER_SCROLL_MS 300000 // pomalý hardwarový scroll, po probuzení se snímek pošle znovu
+#define OLED_FB_ORIENTATION OLED_ORIENT_0 // orientace po startu, za běhu oled_fb_set_orientation()
+
+// #define OLED_NO_ANIMATION // přepnutí vrstvy bez přechodové animace
+// #define OLED_NO_PREFETCH // snímky se dekódují až při přepnutí (srovnání latence hit/miss v oled_prefetch stats)
+// #define OLED_TEXT_BENCHMARK // po startu změří kreslení textu (oled_text stats), stojí 512 B RAM navíc
+// #define OLED_GRAY_STATUS // settings vrstva ve stupních šedi (ztlumený obrázek, jasný text), potřebuje rychlou sběrnici
+#define OLED_GRAY_PLANE_HZ 180 // výměn rovin za sekundu, 3 roviny na cyklus
+#define OLED_GRAY_MAX_PAGES 2 // nejvíc stránek odeslaných na jeden průchod smyčkou
+
+#define TRACE_LEVEL TRACE_OFF // TRACE_INFO / TRACE_DEBUG / TRACE_VERBOSE pro ladicí build, výpis tools/trace_decode.py
+#define TRACE_RING_SIZE 128 // záznamů v RAM (16 B na záznam)
+
+#define RAM_BUDGET_OLED 4608 // rozpočty statické RAM podsystémů v B, překročení zastaví překlad (ram_watch.c)
+#define RAM_BUDGET_HAPTIC 16
+#define RAM_BUDGET_KEYMAP 1280 // cache keymapy profilu, stránka odloženého zápisu banky + tabulky chordů
+#define RAM_BUDGET_VIA 64
+#define RAM_BUDGET_BUFFERS 4096 // makra, trasování, heatmapa, fronta událostí
+
 #endif 
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include QMK_KEYBOARD_H
+
+#include "debounce.h"
+#include "user_settings.h"
+
+// Debounce sym_defer_g jako v QMK, jen s dobou z user_settings místo DEBOUNCE:
+// po poslední změně kterékoli klávesy se čeká debounce_ms a pak se převezme celá
+// matice. Změna z VIA tak platí hned od dalšího scanu.
+
+static bool     debouncing = false;
+static uint16_t changed_ms = 0;
+
+void debounce_init(uint8_t num_rows) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    if (changed) {
+        debouncing = true;
+        changed_ms = timer_read();
+    }
+
+    if (!debouncing || timer_elapsed(changed_ms) < user_settings.debounce_ms) {
+        return false;
+    }
+
+    debouncing = false;
+
+    bool cooked_changed = memcmp(cooked, raw, sizeof(matrix_row_t) * num_rows) != 0;
+
+    memcpy(cooked, raw, sizeof(matrix_row_t) * num_rows);
+    return cooked_changed;
+}
+
+void debounce_free(void) {}
@@ -0,0 +1,99 @@
+#include QMK_KEYBOARD_H
+
+#include "event_bus.h"
+#include "trace.h"
+#include "ram_watch.h"
+
+// Oznamování změn stavu mezi moduly místo kontroly globálních proměnných v každém
+// průchodu smyčkou. Obsluhy se volají synchronně z event_publish, takže displej
+// i haptika reagují ve stejném průchodu jako dřív. Událost zveřejněná z obsluhy
+// (nebo z jiné události) se zařadí do fronty a doručí se po té právě probíhající,
+// pořadí tak zůstává stejné jako pořadí zveřejnění. Plná fronta událost zahodí
+// a započítá, tabulka odběrů ani fronta nikdy nealokují.
+
+typedef struct {
+    uint8_t         type;
+    event_handler_t handler;
+} subscription_t;
+
+static subscription_t subscriptions[EVENT_BUS_MAX_SUBSCRIBERS];
+static uint8_t        subscription_count = 0;
+
+static event_t queue[EVENT_BUS_QUEUE_SIZE];
+RAM_ACCOUNT(sizeof(subscriptions) + sizeof(queue), EVENT_BUS_RAM);
+static uint8_t queue_head  = 0;
+static uint8_t queue_count = 0;
+static bool    dispatching = false;
+
+static event_bus_stats_t stats;
+static uint32_t          window_start     = 0;
+static uint16_t          window_callbacks = 0;
+static uint32_t          window_ticks     = 0;
+
+bool event_subscribe(event_type_t type, event_handler_t handler) {
+    if (type >= EVENT_TYPES || subscription_count >= EVENT_BUS_MAX_SUBSCRIBERS) {
+        stats.subscribe_failed++;
+        TRACE(EVENT_SUBSCRIBE_FAILED, type, subscription_count);
+        return false;
+    }
+
+    subscriptions[subscription_count].type    = type;
+    subscriptions[subscription_count].handler = handler;
+    subscription_count++;
+    return true;
+}
+
+static void dispatch(const event_t *event) {
+    for (uint8_t i = 0; i < subscription_count; i++) {
+        if (subscriptions[i].type != event->type) continue;
+
+        subscriptions[i].handler(event);
+        stats.callbacks++;
+        window_callbacks++;
+    }
+}
+
+void event_publish(event_type_t type, uint32_t old_value, uint32_t new_value) {
+    if (queue_count >= EVENT_BUS_QUEUE_SIZE) {
+        stats.dropped++;
+        TRACE(EVENT_DROPPED, type, new_value);
+        return;
+    }
+
+    event_t *slot = &queue[(queue_head + queue_count) % EVENT_BUS_QUEUE_SIZE];
+
+    slot->type      = type;
+    slot->old_value = old_value;
+    slot->new_value = new_value;
+    queue_count++;
+    stats.published++;
+    if (queue_count > stats.max_queued) stats.max_queued = queue_count;
+
+    if (dispatching) return; // doručí vnější event_publish po aktuální události
+
+    dispatching = true;
+    while (queue_count) {
+        event_t event = queue[queue_head]; // kopie, obsluha může frontu dál plnit
+
+        queue_head = (queue_head + 1) % EVENT_BUS_QUEUE_SIZE;
+        queue_count--;
+        dispatch(&event);
+    }
+    dispatching = false;
+}
+
+void event_bus_task(void) {
+    window_ticks++;
+
+    if (timer_elapsed32(window_start) >= EVENT_BUS_STATS_WINDOW_MS) {
+        stats.callbacks_per_second = (uint32_t)window_callbacks * 1000 / EVENT_BUS_STATS_WINDOW_MS;
+        stats.ticks_per_second     = (uint64_t)window_ticks * 1000 / EVENT_BUS_STATS_WINDOW_MS;
+        window_callbacks           = 0;
+        window_ticks               = 0;
+        window_start               = timer_read32();
+    }
+}
+
+const event_bus_stats_t *event_bus_stats(void) {
+    return &stats;
+}
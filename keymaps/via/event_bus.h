@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef EVENT_BUS_MAX_SUBSCRIBERS
+#    define EVENT_BUS_MAX_SUBSCRIBERS 8 // všechny odběry dohromady, registrují se jen při startu
+#endif
+#ifndef EVENT_BUS_QUEUE_SIZE
+#    define EVENT_BUS_QUEUE_SIZE 8 // události zveřejněné z obsluhy jiné události
+#endif
+#ifndef EVENT_BUS_STATS_WINDOW_MS
+#    define EVENT_BUS_STATS_WINDOW_MS 1000 // okno pro výpočet obsluh za sekundu
+#endif
+
+#define EVENT_BUS_RAM (EVENT_BUS_MAX_SUBSCRIBERS * 2 * sizeof(event_handler_t) + EVENT_BUS_QUEUE_SIZE * sizeof(event_t))
+
+typedef enum {
+    EVENT_LAYER_CHANGED,  // old/new = layer_state
+    EVENT_DESIGN_CHANGED, // old/new = display_design
+    EVENT_HAPTIC_CHANGED, // old/new = haptic_config.raw (zapnutí, dwell, ...)
+    EVENT_TYPES,
+} event_type_t;
+
+typedef struct {
+    uint8_t  type; // event_type_t
+    uint32_t old_value;
+    uint32_t new_value;
+} event_t;
+
+typedef void (*event_handler_t)(const event_t *event);
+
+typedef struct {
+    uint32_t published;
+    uint32_t callbacks;            // zavolané obsluhy
+    uint32_t dropped;              // plná fronta
+    uint16_t callbacks_per_second; // v posledním okně EVENT_BUS_STATS_WINDOW_MS
+    uint32_t ticks_per_second;     // průchody smyčkou ve stejném okně = kolikrát se dřív stav kontroloval
+    uint8_t  max_queued;
+    uint8_t  subscribe_failed;     // odmítnuté odběry (plná tabulka, neznámý typ), obsluha pak nikdy nepřijde
+} event_bus_stats_t;
+
+bool event_subscribe(event_type_t type, event_handler_t handler); // false = plná tabulka odběrů
+void event_publish(event_type_t type, uint32_t old_value, uint32_t new_value); // obsluhy proběhnou hned, v pořadí přihlášení
+void event_bus_task(void); // jen statistika, jednou za průchod hlavní smyčkou
+
+const event_bus_stats_t *event_bus_stats(void);
@@ -0,0 +1,104 @@
+#include QMK_KEYBOARD_H
+
+#include "pico/platform.h"
+#include "pico/bootrom.h"
+#include "hardware/sync.h"
+#include "hardware/regs/addressmap.h"
+
+#include "flash_store.h"
+#include "ram_watch.h"
+#include "timing.h"
+
+// Zápis do flash přes funkce v ROM RP2040, stejně jako hardware_flash v pico-sdk.
+// Během mazání/zápisu neběží XIP, proto vše, co se volá mezi exit_xip a návratem
+// do XIP, musí ležet v RAM a přerušení musí být vypnutá.
+
+#define FLASH_BLOCK_SIZE (1u << 16)
+#define FLASH_BLOCK_ERASE_CMD 0xd8
+#define BOOT2_SIZE_WORDS 64
+
+typedef void (*rom_void_fn)(void);
+typedef void (*rom_erase_fn)(uint32_t addr, size_t count, uint32_t block_size, uint8_t block_cmd);
+typedef void (*rom_program_fn)(uint32_t addr, const uint8_t *data, size_t count);
+
+static uint32_t boot2_copyout[BOOT2_SIZE_WORDS]; // boot2 pro návrat do rychlého XIP režimu
+static bool     boot2_copyout_valid = false;
+
+static flash_store_stats_t stats;
+
+static void __no_inline_not_in_flash_func(boot2_copy)(void) {
+    if (boot2_copyout_valid) return;
+
+    for (int i = 0; i < BOOT2_SIZE_WORDS; i++) {
+        boot2_copyout[i] = ((const uint32_t *)XIP_BASE)[i];
+    }
+    __compiler_memory_barrier();
+    boot2_copyout_valid = true;
+}
+
+static void __no_inline_not_in_flash_func(flash_erase_raw)(uint32_t offset) {
+    rom_void_fn  connect_internal_flash = (rom_void_fn)rom_func_lookup_inline(rom_table_code('I', 'F'));
+    rom_void_fn  flash_exit_xip         = (rom_void_fn)rom_func_lookup_inline(rom_table_code('E', 'X'));
+    rom_erase_fn flash_range_erase      = (rom_erase_fn)rom_func_lookup_inline(rom_table_code('R', 'E'));
+    rom_void_fn  flash_flush_cache      = (rom_void_fn)rom_func_lookup_inline(rom_table_code('F', 'C'));
+
+    boot2_copy();
+    __compiler_memory_barrier();
+
+    connect_internal_flash();
+    flash_exit_xip();
+    flash_range_erase(offset, FLASH_STORE_SECTOR_SIZE, FLASH_BLOCK_SIZE, FLASH_BLOCK_ERASE_CMD);
+    flash_flush_cache();
+    ((rom_void_fn)((intptr_t)boot2_copyout + 1))();
+}
+
+static void __no_inline_not_in_flash_func(flash_program_raw)(uint32_t offset, const uint8_t *data) {
+    rom_void_fn    connect_internal_flash = (rom_void_fn)rom_func_lookup_inline(rom_table_code('I', 'F'));
+    rom_void_fn    flash_exit_xip         = (rom_void_fn)rom_func_lookup_inline(rom_table_code('E', 'X'));
+    rom_program_fn flash_range_program    = (rom_program_fn)rom_func_lookup_inline(rom_table_code('R', 'P'));
+    rom_void_fn    flash_flush_cache      = (rom_void_fn)rom_func_lookup_inline(rom_table_code('F', 'C'));
+
+    boot2_copy();
+    __compiler_memory_barrier();
+
+    connect_internal_flash();
+    flash_exit_xip();
+    flash_range_program(offset, data, FLASH_STORE_PAGE_SIZE);
+    flash_flush_cache();
+    ((rom_void_fn)((intptr_t)boot2_copyout + 1))();
+}
+
+void flash_store_erase_sector(uint32_t offset) {
+    uint32_t start = timing_us();
+    uint32_t irq   = save_and_disable_interrupts();
+
+    flash_erase_raw(offset);
+
+    restore_interrupts(irq);
+    stats.last_erase_us = timing_us() - start;
+    stats.sectors_erased++;
+}
+
+void flash_store_program_page(uint32_t offset, const void *data) {
+    static uint8_t page[FLASH_STORE_PAGE_SIZE]; // zdroj nesmí ležet ve flash, kopie do RAM
+    RAM_ACCOUNT(sizeof(page), FLASH_STORE_RAM);
+
+    memcpy(page, data, FLASH_STORE_PAGE_SIZE);
+
+    uint32_t start = timing_us();
+    uint32_t irq   = save_and_disable_interrupts();
+
+    flash_program_raw(offset, page);
+
+    restore_interrupts(irq);
+    stats.last_program_us = timing_us() - start;
+    stats.pages_programmed++;
+}
+
+const void *flash_store_read(uint32_t offset) {
+    return (const void *)(uintptr_t)(XIP_NOCACHE_NOALLOC_BASE + offset);
+}
+
+const flash_store_stats_t *flash_store_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+// Uživatelská oblast ve flash. Leží pod wear-leveling EEPROM na konci prvních 2 MB,
+// takže funguje i na deskách s menší flash než má KB2040 (8 MB).
+#ifndef USER_FLASH_OFFSET
+#    define USER_FLASH_OFFSET 0x1C0000
+#endif
+#ifndef USER_FLASH_SIZE
+#    define USER_FLASH_SIZE 0x30000
+#endif
+
+#define FLASH_STORE_SECTOR_SIZE 4096 // nejmenší mazatelný blok
+#define FLASH_STORE_PAGE_SIZE 256    // nejmenší programovatelný blok
+#define FLASH_STORE_RAM FLASH_STORE_PAGE_SIZE // kopie programované stránky v RAM
+
+// rozdělení uživatelské oblasti
+#define MACRO_FLASH_OFFSET USER_FLASH_OFFSET
+#define MACRO_FLASH_SIZE 0x10000
+#define HEATMAP_FLASH_OFFSET (MACRO_FLASH_OFFSET + MACRO_FLASH_SIZE)
+#define HEATMAP_FLASH_SIZE 0x2000 // dva sektory, zápisy se v nich střídají
+#define PROFILE_FLASH_OFFSET (HEATMAP_FLASH_OFFSET + HEATMAP_FLASH_SIZE)
+#define PROFILE_FLASH_SIZE 0x7000 // sektor na banku profilu, banky se mažou nezávisle
+
+_Static_assert(USER_FLASH_OFFSET % FLASH_STORE_SECTOR_SIZE == 0, "USER_FLASH_OFFSET musí být zarovnaný na sektor");
+_Static_assert(PROFILE_FLASH_OFFSET + PROFILE_FLASH_SIZE <= USER_FLASH_OFFSET + USER_FLASH_SIZE, "oblasti nesmí přesáhnout USER_FLASH_SIZE");
+
+typedef struct {
+    uint32_t sectors_erased;
+    uint32_t pages_programmed;
+    uint32_t last_erase_us;   // jak dlouho bylo zablokované XIP při posledním mazání
+    uint32_t last_program_us; // jak dlouho bylo zablokované XIP při posledním zápisu stránky
+} flash_store_stats_t;
+
+void flash_store_erase_sector(uint32_t offset);                    // offset zarovnaný na FLASH_STORE_SECTOR_SIZE
+void flash_store_program_page(uint32_t offset, const void *data);  // offset zarovnaný na FLASH_STORE_PAGE_SIZE
+const void *flash_store_read(uint32_t offset);                     // přímé čtení přes XIP (bez cache)
+
+const flash_store_stats_t *flash_store_stats(void);
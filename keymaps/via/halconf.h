@@ -0,0 +1,5 @@
+#pragma once
+
+#define PAL_USE_CALLBACKS TRUE // přerušení od hran na pinech sloupců pro probuzení z idle režimu
+
+#include_next <halconf.h>
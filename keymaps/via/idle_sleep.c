@@ -0,0 +1,153 @@
+#include QMK_KEYBOARD_H
+
+#include "hal.h"
+
+#include "idle_sleep.h"
+#include "macro_recorder.h"
+#include "matrix_sampler.h"
+#include "oled_saver.h"
+#include "report_coalesce.h"
+#include "timing.h"
+
+// Po vypršení IDLE_TIMEOUT se místo skenování matice stáhnou všechny řádky do nuly
+// a na sloupcích se zapnou přerušení od sestupné hrany (COL2ROW: stisk stáhne sloupec).
+// Procesor pak spí ve WFI, dokud nepřijde hrana nebo neuplyne IDLE_MAX_SLEEP_MS.
+// Stisk, který probudil, zůstává držený, takže ho normálně zachytí další scan.
+// Data z USB přijme přerušení ovladače, ale raw HID (VIA, nástroje v tools/) je čte
+// až hlavní smyčka, proto je spánek dlouhý nejvýš jeden interval dotazování USB.
+// Přerušení USB jako zdroj probuzení nestačí: SOF chodí každou 1 ms a buffer
+// přijatý těsně před WFI by obsloužilo dřív, než by ho smyčka stihla zaznamenat.
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static virtual_timer_t sleep_timer;
+static bool            sleep_timer_ready = false;
+static volatile bool   key_edge  = false;
+static volatile bool   timed_out = false;
+
+static idle_stats_t stats;
+static bool         waiting_report  = false;
+static uint32_t     wake_us         = 0;
+static uint32_t     reports_at_wake = 0;
+
+static void col_edge_cb(void *arg) {
+    key_edge = true;
+}
+
+static void sleep_timeout_cb(virtual_timer_t *vtp, void *arg) {
+    timed_out = true;
+}
+
+static bool can_idle(void) {
+#ifdef OLED_ENABLE
+    if (is_oled_on() && !oled_saver_active()) return false; // spořič posílá jen pár příkazů za minutu, spánek mu nevadí
+#endif
+    if (last_input_activity_elapsed() < IDLE_TIMEOUT) return false;
+    if (macro_recorder_state() != MACRO_IDLE) return false;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) return false; // držená klávesa, hrana by nepřišla
+    }
+    return true;
+}
+
+static void arm(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        gpio_set_pin_output(row_pins[row]);
+        gpio_write_pin_low(row_pins[row]);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        gpio_set_pin_input_high(col_pins[col]);
+        palSetLineCallback(col_pins[col], col_edge_cb, NULL);
+        palEnableLineEvent(col_pins[col], PAL_EVENT_MODE_FALLING_EDGE);
+    }
+}
+
+static void disarm(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        palDisableLineEvent(col_pins[col]);
+    }
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        gpio_set_pin_input_high(row_pins[row]); // stejný klidový stav jako po unselect_row
+    }
+}
+
+static bool any_col_low(void) {
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (!gpio_read_pin(col_pins[col])) return true;
+    }
+    return false;
+}
+
+static void track_wake_latency(void) {
+    const report_stats_t *reports = report_coalesce_stats();
+
+    if (!waiting_report || reports->reports_sent == reports_at_wake) return;
+
+    uint32_t latency = reports->last_report_us - wake_us;
+
+    stats.wake_latency_last_us = latency;
+    if (latency > stats.wake_latency_max_us) stats.wake_latency_max_us = latency;
+    waiting_report = false;
+}
+
+void idle_sleep_task(void) {
+    track_wake_latency();
+
+    if (!can_idle()) return;
+
+    key_edge  = false;
+    timed_out = false;
+#ifdef MATRIX_SAMPLER
+    matrix_sampler_stop(); // řádky teď patří spánku, vzorkování by probouzelo WFI
+#endif
+    arm();
+
+    // klávesa mohla být stisknuta dřív, než se přerušení zapnula
+    if (any_col_low()) {
+        disarm();
+#ifdef MATRIX_SAMPLER
+        matrix_sampler_start();
+#endif
+        return;
+    }
+
+    if (!sleep_timer_ready) {
+        chVTObjectInit(&sleep_timer);
+        sleep_timer_ready = true;
+    }
+
+    uint32_t start = timing_us();
+
+    chVTSet(&sleep_timer, TIME_MS2I(IDLE_MAX_SLEEP_MS), sleep_timeout_cb, NULL);
+    while (!key_edge && !timed_out) {
+        // WFI se zakázanými přerušeními: čekající přerušení procesor probudí, ale
+        // obslouží se až po __enable_irq, takže hrana mezi kontrolou a WFI se neztratí
+        __disable_irq();
+        if (!key_edge && !timed_out) {
+            __WFI();
+        }
+        __enable_irq();
+    }
+    chVTReset(&sleep_timer);
+
+    disarm();
+#ifdef MATRIX_SAMPLER
+    matrix_sampler_start();
+#endif
+
+    stats.idle_us += timing_us() - start;
+    stats.sleeps++;
+
+    if (key_edge) {
+        stats.key_wakeups++;
+        wake_us         = timing_us();
+        reports_at_wake = report_coalesce_stats()->reports_sent;
+        waiting_report  = true;
+    }
+}
+
+const idle_stats_t *idle_sleep_stats(void) {
+    return &stats;
+}
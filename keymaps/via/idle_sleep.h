@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifndef IDLE_TIMEOUT
+#    define IDLE_TIMEOUT 20000 // nečinnost v ms, po které se přestane skenovat matice
+#endif
+#ifndef IDLE_MAX_SLEEP_MS
+#    define IDLE_MAX_SLEEP_MS 1 // nejdelší jednorázový spánek, pak proběhne jeden průchod smyčkou (a raw HID)
+#endif
+
+typedef struct {
+    uint64_t idle_us;               // celkový čas strávený ve WFI
+    uint32_t sleeps;                // počet usnutí
+    uint32_t key_wakeups;           // probuzení hranou na sloupci
+    uint32_t wake_latency_last_us;  // probuzení -> první odeslaný report
+    uint32_t wake_latency_max_us;
+} idle_stats_t;
+
+void idle_sleep_task(void);
+
+const idle_stats_t *idle_sleep_stats(void);
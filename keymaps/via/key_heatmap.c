@@ -0,0 +1,313 @@
+#include QMK_KEYBOARD_H
+
+#include "keymap_user.h"
+#include "key_heatmap.h"
+#include "event_bus.h"
+#include "flash_store.h"
+#include "macro_recorder.h"
+#include "ram_watch.h"
+#include "timing.h"
+#ifdef OLED_ENABLE
+#    include "oled_fb.h"
+#    include "oled_text.h"
+#endif
+
+// Čítače stisků a doby držení pro každou (vrstvu, klávesu). Cesta pro událost je jen
+// index z tabulky a nasycené přičtení, vrstvu si modul drží z EVENT_LAYER_CHANGED.
+// Do flash se ukládá celý záznam (2 stránky) do další volné pozice ve dvou sektorech:
+// hlavička s magic a pořadovým číslem je na konci záznamu, takže nedopsaný záznam je
+// neplatný, a sektor se maže jen při přechodu do něj, zatímco druhý drží poslední stav.
+
+#define HEATMAP_MAGIC 0x484D // 'HM'
+#define RECORD_SIZE (2 * FLASH_STORE_PAGE_SIZE)
+#define RECORD_SLOTS (HEATMAP_FLASH_SIZE / RECORD_SIZE)
+#define SLOTS_PER_SECTOR (FLASH_STORE_SECTOR_SIZE / RECORD_SIZE)
+#define BENCHMARK_EVENTS 1000
+
+typedef struct {
+    uint32_t hold_ms[HEATMAP_LAYERS][KEY_COUNT];
+    uint16_t presses[HEATMAP_LAYERS][KEY_COUNT];
+    uint16_t seq;
+    uint16_t magic; // poslední, zapisuje se ve druhé stránce
+} heatmap_record_t;
+
+_Static_assert(sizeof(heatmap_record_t) <= RECORD_SIZE, "záznam heatmapy se nevejde do dvou stránek");
+
+static union {
+    heatmap_record_t record;
+    uint8_t          pages[2][FLASH_STORE_PAGE_SIZE];
+} store;
+
+static uint8_t  current_layer = 0;
+static uint8_t  press_layer[KEY_COUNT];
+static uint16_t press_time[KEY_COUNT];
+RAM_ACCOUNT(sizeof(store) + sizeof(press_layer) + sizeof(press_time), HEATMAP_RAM);
+static uint16_t held_keys  = 0; // puštění bez započítaného stisku se nepřičítá
+static bool     dirty      = false;
+static uint8_t  next_slot  = 0;
+static bool     slot_ready = false; // sektor pro next_slot je smazaný
+static uint32_t last_save  = 0;
+
+static heatmap_stats_t stats;
+
+#ifdef OLED_ENABLE
+static bool view_stale = true;
+#endif
+
+static const heatmap_record_t *slot_record(uint8_t slot) {
+    return (const heatmap_record_t *)flash_store_read(HEATMAP_FLASH_OFFSET + slot * RECORD_SIZE);
+}
+
+static bool slot_blank(uint8_t slot) {
+    const uint32_t *words = flash_store_read(HEATMAP_FLASH_OFFSET + slot * RECORD_SIZE);
+
+    for (uint16_t i = 0; i < RECORD_SIZE / 4; i++) {
+        if (words[i] != UINT32_MAX) return false;
+    }
+    return true;
+}
+
+static void on_layer_changed(const event_t *event) { // ať se vrstva nezjišťuje při každém stisku
+    uint8_t layer = get_highest_layer(event->new_value);
+
+    current_layer = layer < HEATMAP_LAYERS ? layer : HEATMAP_LAYERS - 1;
+}
+
+void key_heatmap_init(void) {
+    int8_t best = -1;
+
+    if (!event_subscribe(EVENT_LAYER_CHANGED, on_layer_changed)) { // stisky by se počítaly do startovní vrstvy
+        dprintf("heatmap: no layer subscription\n");
+    }
+
+    for (uint8_t slot = 0; slot < RECORD_SLOTS; slot++) {
+        const heatmap_record_t *record = slot_record(slot);
+
+        if (record->magic != HEATMAP_MAGIC) continue;
+        if (best < 0 || (int16_t)(record->seq - slot_record(best)->seq) > 0) best = slot;
+    }
+
+    if (best >= 0) {
+        memcpy(&store.record, slot_record(best), sizeof(store.record));
+        next_slot = (best + 1) % RECORD_SLOTS;
+        // nedopsaný záznam po výpadku slot zabral, zapisovat se dá jen do smazaného
+        while (next_slot % SLOTS_PER_SECTOR != 0 && !slot_blank(next_slot)) {
+            next_slot = (next_slot + 1) % RECORD_SLOTS;
+        }
+        // zbytek sektoru za posledním záznamem je ještě smazaný
+        slot_ready = next_slot % SLOTS_PER_SECTOR != 0;
+    }
+}
+
+void key_heatmap_record(keyrecord_t *record) {
+    int8_t key = key_index(record->event.key);
+
+    if (key < 0) return;
+
+    if (record->event.pressed) {
+        uint16_t *presses = &store.record.presses[current_layer][key];
+
+        if (*presses != UINT16_MAX) (*presses)++;
+        press_layer[key] = current_layer; // puštění se připíše vrstvě, na které klávesa začala
+        press_time[key]  = record->event.time;
+        held_keys |= 1 << key;
+    } else {
+        if (!(held_keys & (1 << key))) return;
+        held_keys &= ~(1 << key);
+
+        uint16_t  held = record->event.time - press_time[key];
+        uint32_t *hold = &store.record.hold_ms[press_layer[key]][key];
+
+        *hold = *hold > UINT32_MAX - held ? UINT32_MAX : *hold + held;
+    }
+
+    dirty = true;
+    stats.events++;
+#ifdef OLED_ENABLE
+    view_stale = true;
+#endif
+}
+
+void key_heatmap_task(void) {
+    if (!dirty || timer_elapsed32(last_save) < HEATMAP_SAVE_MS) return;
+    if (last_input_activity_elapsed() < HEATMAP_SAVE_IDLE_MS) return;
+    if (macro_recorder_state() != MACRO_IDLE) return; // makro má s flash přednost
+
+    uint32_t offset = HEATMAP_FLASH_OFFSET + next_slot * RECORD_SIZE;
+
+    if (!slot_ready) { // mazání je delší blokující krok, zápis až v dalším průchodu
+        flash_store_erase_sector(offset);
+        slot_ready = true;
+        return;
+    }
+
+    uint32_t start = timing_us();
+
+    store.record.seq++;
+    store.record.magic = HEATMAP_MAGIC;
+    flash_store_program_page(offset, store.pages[0]);
+    flash_store_program_page(offset + FLASH_STORE_PAGE_SIZE, store.pages[1]);
+
+    stats.save_us = timing_us() - start;
+    stats.saves++;
+
+    next_slot  = (next_slot + 1) % RECORD_SLOTS;
+    slot_ready = next_slot % SLOTS_PER_SECTOR != 0;
+    last_save  = timer_read32();
+    dirty      = false;
+}
+
+static uint32_t benchmark(void) { // náklad započítání události, čítače se pak vrátí
+    keyrecord_t record = {.event = {.key = {.row = 0, .col = 0}, .time = 1}};
+    int8_t      key    = key_index(record.event.key);
+
+    if (key < 0) return 0;
+
+    // měří se jen klávesa key na aktuální vrstvě, stačí uschovat její dva čítače
+    bool     was_dirty   = dirty;
+    uint16_t was_held    = held_keys;
+    uint8_t  was_layer   = press_layer[key];
+    uint16_t was_time    = press_time[key];
+    uint16_t was_presses = store.record.presses[current_layer][key];
+    uint32_t was_hold    = store.record.hold_ms[current_layer][key];
+
+    uint32_t start = timing_us();
+
+    for (uint16_t i = 0; i < BENCHMARK_EVENTS / 2; i++) {
+        record.event.pressed = true;
+        key_heatmap_record(&record);
+        record.event.pressed = false;
+        key_heatmap_record(&record);
+    }
+
+    uint32_t spent = timing_us() - start;
+
+    store.record.presses[current_layer][key] = was_presses;
+    store.record.hold_ms[current_layer][key] = was_hold;
+    dirty            = was_dirty;
+    held_keys        = was_held;
+    press_layer[key] = was_layer;
+    press_time[key]  = was_time;
+    stats.events -= BENCHMARK_EVENTS;
+    return spent;
+}
+
+void key_heatmap_command(uint8_t *data) {
+    uint8_t  op    = data[1];
+    uint8_t  layer = data[2];
+    uint8_t  first = data[3];
+    uint8_t *out   = &data[5];
+    bool     ok    = layer < HEATMAP_LAYERS && first < KEY_COUNT;
+
+    data[3] = layer;
+    data[4] = first;
+    if (!ok) {
+        data[2] = RAW_HID_INVALID;
+        return;
+    }
+
+    switch (op) {
+        case HEATMAP_READ_PRESSES:
+            memcpy(out, store.record.presses[layer], sizeof(store.record.presses[layer]));
+            break;
+
+        case HEATMAP_READ_HOLD: {
+            uint8_t count = KEY_COUNT - first < 6 ? KEY_COUNT - first : 6;
+            memcpy(out, &store.record.hold_ms[layer][first], count * sizeof(uint32_t));
+            break;
+        }
+
+        case HEATMAP_RESET:
+            memset(store.record.presses, 0, sizeof(store.record.presses));
+            memset(store.record.hold_ms, 0, sizeof(store.record.hold_ms));
+            dirty = true;
+#ifdef OLED_ENABLE
+            view_stale = true;
+#endif
+            break;
+
+        case HEATMAP_BENCHMARK: {
+            uint32_t spent = benchmark();
+            memcpy(out, &spent, sizeof(spent));
+            break;
+        }
+
+        default:
+            ok = false;
+            break;
+    }
+
+    data[2] = ok ? RAW_HID_OK : RAW_HID_INVALID;
+}
+
+#ifdef OLED_ENABLE
+
+// výplně buňky (sloupcové bajty, střídají se sudé/liché sloupce): 0 %, 25 %, 50 %, 75 %, 100 %
+static const uint8_t fill[5][2] = {{0x00, 0x00}, {0x11, 0x44}, {0x55, 0xAA}, {0xEE, 0xBB}, {0xFF, 0xFF}};
+
+#define CELL_PX (4 * OLED_TEXT_GLYPH_WIDTH) // stejná mřížka jako legenda: 4 znaky + mezera
+#define CELL_PITCH_PX (5 * OLED_TEXT_GLYPH_WIDTH)
+
+static uint8_t           shown_level[KEY_COUNT];
+static uint8_t           shown_layer = 0xFF;
+static uint32_t          last_view   = 0;
+static oled_text_field_t header      = {.row = 0, .col = 0, .width = OLED_TEXT_COLS};
+
+void key_heatmap_invalidate(void) {
+    shown_layer = 0xFF;
+}
+
+void key_heatmap_draw(uint8_t *buf, uint8_t layer) {
+    if (layer >= HEATMAP_LAYERS) return;
+
+    if (layer != shown_layer) { // nová vrstva nebo návrat do pohledu: celý snímek
+        memset(buf, 0, OLED_FB_SIZE);
+        memset(shown_level, 0xFF, sizeof(shown_level));
+        oled_text_field_reset(&header);
+        shown_layer = layer;
+        view_stale  = true;
+    } else if (!view_stale || timer_elapsed32(last_view) < HEATMAP_VIEW_MS) {
+        return;
+    }
+
+    view_stale = false;
+    last_view  = timer_read32();
+
+    const uint16_t *presses = store.record.presses[layer];
+    uint32_t        total   = 0;
+    uint16_t        max     = 0;
+
+    for (uint8_t key = 0; key < KEY_COUNT; key++) {
+        total += presses[key];
+        if (presses[key] > max) max = presses[key];
+    }
+
+    char line[OLED_TEXT_COLS + 1] = "Heat L0 ";
+
+    line[6] = '0' + layer;
+    strcat(line, get_u16_str(total > UINT16_MAX ? UINT16_MAX : (uint16_t)total, ' '));
+    oled_text_field(buf, &header, line);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            int8_t key = key_index_map[row][col];
+            if (key < 0) continue;
+
+            uint8_t level = presses[key] == 0 ? 0 : 1 + (uint32_t)3 * presses[key] / max;
+            if (level > 4) level = 4;
+            if (level == shown_level[key]) continue;
+
+            uint8_t *dst = buf + (row + 1) * OLED_FB_WIDTH + OLED_TEXT_GLYPH_WIDTH + col * CELL_PITCH_PX;
+
+            for (uint8_t x = 0; x < CELL_PX - 1; x++) { // poslední sloupec zůstane jako mezera
+                dst[x] = fill[level][x & 1];
+            }
+            shown_level[key] = level;
+        }
+    }
+}
+#endif
+
+const heatmap_stats_t *key_heatmap_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "key_index.h"
+
+#define HEATMAP_LAYERS 4 // DYNAMIC_KEYMAP_LAYER_COUNT
+#define HEATMAP_RAM (2 * FLASH_STORE_PAGE_SIZE + KEY_COUNT * 3) // záznam pro flash + vrstva a čas stisku každé klávesy
+
+#ifndef HEATMAP_SAVE_MS
+#    define HEATMAP_SAVE_MS 600000 // změněné čítače se ukládají nejvýš jednou za 10 minut
+#endif
+#ifndef HEATMAP_SAVE_IDLE_MS
+#    define HEATMAP_SAVE_IDLE_MS 2000 // a jen když pad chvíli nikdo nepoužívá (zápis blokuje XIP)
+#endif
+#ifndef HEATMAP_VIEW_MS
+#    define HEATMAP_VIEW_MS 250 // nejčastější překreslení heatmapy na displeji
+#endif
+
+// podpříkazy RAW_HID_HEATMAP: [0x41, op, vrstva, první klávesa] -> [0x41, op, stav, vrstva, první klávesa, data...]
+enum heatmap_ops {
+    HEATMAP_READ_PRESSES = 0, // 11 x uint16 stisků vrstvy
+    HEATMAP_READ_HOLD    = 1, // 6 x uint32 ms držení od první klávesy
+    HEATMAP_RESET        = 2, // vynuluje čítače (uloží se s dalším zápisem)
+    HEATMAP_BENCHMARK    = 3, // uint32 µs na 1000 událostí, čítače se nezmění
+};
+
+typedef struct {
+    uint32_t saves;
+    uint32_t save_us; // poslední zápis do flash
+    uint32_t events;  // započítané události (stisk i puštění)
+} heatmap_stats_t;
+
+void key_heatmap_init(void);               // načte poslední uložený stav z flash, přihlásí se k EVENT_LAYER_CHANGED
+void key_heatmap_record(keyrecord_t *record);
+void key_heatmap_task(void);               // odložené ukládání
+void key_heatmap_command(uint8_t *data);   // raw HID, odpověď se zapíše do data
+
+#ifdef OLED_ENABLE
+void key_heatmap_draw(uint8_t *buf, uint8_t layer); // mřížka LAYOUT_martin_3x3, hustota výplně = podíl stisků
+void key_heatmap_invalidate(void);
+#endif
+
+const heatmap_stats_t *key_heatmap_stats(void);
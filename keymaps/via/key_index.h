@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+#define KEY_COUNT 11 // počet fyzických kláves v LAYOUT_martin_3x3
+
+// pořadí kláves odpovídá argumentům LAYOUT_martin_3x3, -1 = pozice bez klávesy
+static const int8_t key_index_map[MATRIX_ROWS][MATRIX_COLS] = {
+    {0, 1, 2, 3},
+    {4, 5, 6, -1},
+    {7, 8, 9, 10},
+};
+
+static inline int8_t key_index(keypos_t key) {
+    if (key.row >= MATRIX_ROWS || key.col >= MATRIX_COLS) return -1;
+    return key_index_map[key.row][key.col];
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+// sdílené mezi keymap.c a moduly, které potřebují vlastní keycody nebo stav keymapy
+
+enum keycodes {  //vlastní keycody
+  KC_CYCLE_LAYERS = QK_USER, // keycode pro přepínání vrstev
+  KC_DISPLAY_DESIGN, // keycode pro zmeniu designu displeje
+  KC_MACRO_REC, // start/stop nahrávání makra
+  KC_MACRO_PLAY, // přehrání makra s původním časováním
+  KC_MACRO_PLAY_FAST, // přehrání makra bez prodlev
+  KC_PROFILE_NEXT, // další profil (banka keymapy ve flash)
+
+}; 
+
+enum raw_hid_commands { // vlastní příkazy přes raw HID, VIA má svoje v rozsahu 0x01-0x15 a 0xFF
+  RAW_HID_SET_LAYER = 0x40, // [0x40, vrstva, design] -> [0x40, stav, vrstva, design, µs zpracování (4 B)]
+  RAW_HID_HEATMAP = 0x41, // čítače kláves, podpříkazy viz key_heatmap.h
+  RAW_HID_TRACE = 0x42, // vyčtení záznamů trasování, formát viz trace.h
+  RAW_HID_PROFILE = 0x43, // profily ve flash, podpříkazy viz profile_bank.h
+  RAW_HID_MEMORY = 0x44, // zásobníky a rozpočty RAM, podpříkazy viz ram_watch.h
+  RAW_HID_STATS = 0x45, // čítače modulů (*_stats), formát viz stats_report.h
+};
+
+enum raw_hid_status {
+  RAW_HID_OK = 0,
+  RAW_HID_INVALID = 1, // neplatný parametr, nic se nezměnilo
+};
+
+#define RAW_HID_KEEP 0xFF // parametr, který se nemá měnit
+
+#define DISPLAY_DESIGN_LEGEND 4  // za obrázkovými designy: legenda kláves vykreslená z keymapy
+#define DISPLAY_DESIGN_HEATMAP 5 // heatmapa stisků aktivní vrstvy
+#define DISPLAY_DESIGNS 6        // obrázkové designy (OLED_IMAGE_DESIGNS) + legenda + heatmapa
+
+extern int display_design;
+
+#define HAPTIC_RAM (sizeof(haptic_config_t) + sizeof(bool) + sizeof(uint32_t)) // konfigurace haptiky QMK + haptic_enabled a haptic_state v keymap.c
+
+void display_design_set(uint8_t design); // změna designu -> EVENT_DESIGN_CHANGED
+void haptic_settings_changed(void);      // po změně haptic_config -> EVENT_HAPTIC_CHANGED, pokud se opravdu změnila
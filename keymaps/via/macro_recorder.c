@@ -0,0 +1,215 @@
+#include QMK_KEYBOARD_H
+
+#include "macro_recorder.h"
+#include "flash_store.h"
+#include "ram_watch.h"
+
+// Nahrávání jde do předem alokovaného kruhového bufferu v RAM. Plné stránky (64 událostí)
+// se na pozadí přelévají do flash, ale jen když pad chvíli nikdo nepoužívá, takže
+// zablokované XIP během mazání/zápisu není při psaní znát. Hlavička s počtem událostí
+// se zapíše až na konci, do té doby je makro ve flash neplatné.
+
+#define MACRO_MAGIC 0x4D52 // 'MR'
+#define MACRO_PRESSED 0x8000
+#define MACRO_DELAY_MAX 0x7FFF
+
+#define EVENTS_PER_PAGE (FLASH_STORE_PAGE_SIZE / sizeof(macro_event_t))
+#define DATA_OFFSET FLASH_STORE_PAGE_SIZE // první stránka patří hlavičce
+#define MAX_EVENTS ((MACRO_FLASH_SIZE - DATA_OFFSET) / sizeof(macro_event_t))
+
+_Static_assert((MACRO_RING_EVENTS & (MACRO_RING_EVENTS - 1)) == 0, "MACRO_RING_EVENTS musí být mocnina dvou");
+_Static_assert(MACRO_RING_EVENTS % (FLASH_STORE_PAGE_SIZE / 4) == 0, "MACRO_RING_EVENTS musí být násobek stránky flash");
+
+typedef struct {
+    uint16_t keycode;
+    uint16_t delay; // ms od předchozí události, horní bit = stisk
+} macro_event_t;
+
+typedef struct {
+    uint16_t magic;
+    uint16_t count;
+} macro_header_t;
+
+static macro_event_t ring[MACRO_RING_EVENTS];
+RAM_ACCOUNT(sizeof(ring), MACRO_RING_RAM);
+static uint16_t      ring_head = 0; // volně běžící indexy, maskují se při přístupu
+static uint16_t      ring_tail = 0;
+
+static macro_state_t state        = MACRO_IDLE;
+static uint16_t      recorded     = 0;     // události zaznamenané v aktuálním nahrávání
+static uint16_t      last_time    = 0;     // čas poslední události (record->event.time)
+static uint32_t      last_activity = 0;    // pro odklad zápisu do flash
+static uint32_t      page_offset  = 0;     // kam půjde další stránka dat (relativně k oblasti)
+static uint32_t      erased_until = 0;     // oblast do tohoto offsetu je smazaná
+
+static uint16_t play_index = 0;
+static uint16_t play_count = 0;
+static uint32_t play_due   = 0;
+static bool     play_compressed = false;
+
+static const macro_header_t *stored_header(void) {
+    return (const macro_header_t *)flash_store_read(MACRO_FLASH_OFFSET);
+}
+
+static bool ensure_erased(uint32_t end) {
+    if (end <= erased_until) return true;
+
+    flash_store_erase_sector(MACRO_FLASH_OFFSET + erased_until);
+    erased_until += FLASH_STORE_SECTOR_SIZE;
+    return false; // jeden blokující krok na průchod smyčkou stačí
+}
+
+// přelije jednu stránku z bufferu do flash, vrací true, pokud něco udělal
+static bool spill_page(bool partial) {
+    uint16_t pending = ring_head - ring_tail;
+
+    if (pending == 0 || (!partial && pending < EVENTS_PER_PAGE)) return false;
+    if (!ensure_erased(page_offset + DATA_OFFSET + FLASH_STORE_PAGE_SIZE)) return true;
+
+    macro_event_t page[EVENTS_PER_PAGE];
+    uint16_t      count = pending < EVENTS_PER_PAGE ? pending : EVENTS_PER_PAGE;
+
+    memset(page, 0xFF, sizeof(page));
+    for (uint16_t i = 0; i < count; i++) {
+        page[i] = ring[(ring_tail + i) & (MACRO_RING_EVENTS - 1)];
+    }
+
+    flash_store_program_page(MACRO_FLASH_OFFSET + DATA_OFFSET + page_offset, page);
+    page_offset += FLASH_STORE_PAGE_SIZE;
+    ring_tail += count;
+    return true;
+}
+
+static void finish(void) {
+    if (spill_page(true)) return;
+    if (!ensure_erased(FLASH_STORE_PAGE_SIZE)) return;
+
+    macro_header_t header[FLASH_STORE_PAGE_SIZE / sizeof(macro_header_t)];
+
+    memset(header, 0xFF, sizeof(header));
+    header[0].magic = MACRO_MAGIC;
+    header[0].count = recorded;
+    flash_store_program_page(MACRO_FLASH_OFFSET, header);
+
+    state = MACRO_IDLE;
+}
+
+void macro_recorder_toggle_record(void) {
+    switch (state) {
+        case MACRO_IDLE:
+            ring_head    = 0;
+            ring_tail    = 0;
+            recorded     = 0;
+            page_offset  = 0;
+            erased_until = 0;
+            last_time    = timer_read();
+            state        = MACRO_RECORDING;
+            break;
+
+        case MACRO_RECORDING:
+            state = MACRO_FINISHING;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void macro_recorder_play(bool compressed) {
+    if (state == MACRO_PLAYING) { // druhý stisk přehrávání zastaví
+        state = MACRO_IDLE;
+        clear_keyboard();
+        return;
+    }
+    if (state != MACRO_IDLE) return;
+
+    const macro_header_t *header = stored_header();
+    if (header->magic != MACRO_MAGIC || header->count == 0) return;
+
+    play_index      = 0;
+    play_count      = header->count;
+    play_due        = timer_read32();
+    play_compressed = compressed;
+    state           = MACRO_PLAYING;
+}
+
+void process_macro_recorder(uint16_t keycode, keyrecord_t *record) {
+    last_activity = timer_read32();
+
+    if (state != MACRO_RECORDING || keycode > QK_MODS_MAX) return;
+
+    uint16_t delay = recorded == 0 ? 0 : record->event.time - last_time; // makro začíná první klávesou
+    last_time      = record->event.time;
+
+    // buffer je plný a flash to nestíhá, nebo je plná oblast ve flash: nahrávání končí
+    if ((uint16_t)(ring_head - ring_tail) >= MACRO_RING_EVENTS || recorded >= MAX_EVENTS) {
+        state = MACRO_FINISHING;
+        return;
+    }
+
+    ring[ring_head & (MACRO_RING_EVENTS - 1)] = (macro_event_t){
+        .keycode = keycode,
+        .delay   = (delay > MACRO_DELAY_MAX ? MACRO_DELAY_MAX : delay) | (record->event.pressed ? MACRO_PRESSED : 0),
+    };
+    ring_head++;
+    recorded++;
+}
+
+static void play_step(void) {
+    const macro_event_t *events = (const macro_event_t *)flash_store_read(MACRO_FLASH_OFFSET + DATA_OFFSET);
+
+    for (uint8_t burst = 0; burst < MACRO_PLAY_BURST; burst++) {
+        if (play_index >= play_count) {
+            state = MACRO_IDLE;
+            clear_keyboard(); // klávesy držené při ukončení nahrávání nemají záznam o puštění
+            return;
+        }
+
+        macro_event_t event = events[play_index];
+        if (!play_compressed) {
+            uint32_t due = play_due + (event.delay & MACRO_DELAY_MAX);
+            if (!timer_expired32(timer_read32(), due)) return;
+            play_due = due;
+        }
+
+        if (event.delay & MACRO_PRESSED) {
+            register_code16(event.keycode);
+        } else {
+            unregister_code16(event.keycode);
+        }
+        play_index++;
+    }
+}
+
+void macro_recorder_task(void) {
+    switch (state) {
+        case MACRO_RECORDING: {
+            // při zaplnění 3/4 bufferu se zapisuje i během psaní, jinak by se nahrávka utnula
+            bool pressure = (uint16_t)(ring_head - ring_tail) >= MACRO_RING_EVENTS * 3 / 4;
+            if (pressure || timer_elapsed32(last_activity) >= MACRO_SPILL_IDLE_MS) {
+                spill_page(false);
+            }
+            break;
+        }
+
+        case MACRO_FINISHING:
+            finish();
+            break;
+
+        case MACRO_PLAYING:
+            play_step();
+            break;
+
+        default:
+            break;
+    }
+}
+
+macro_state_t macro_recorder_state(void) {
+    return state;
+}
+
+uint16_t macro_recorder_length(void) {
+    const macro_header_t *header = stored_header();
+    return header->magic == MACRO_MAGIC ? header->count : 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef MACRO_RING_EVENTS
+#    define MACRO_RING_EVENTS 256 // velikost RAM bufferu v událostech (mocnina dvou, 4 B na událost)
+#endif
+#define MACRO_RING_RAM (MACRO_RING_EVENTS * 4)
+#ifndef MACRO_SPILL_IDLE_MS
+#    define MACRO_SPILL_IDLE_MS 150 // zápis do flash jen po této době bez stisku klávesy
+#endif
+#ifndef MACRO_PLAY_BURST
+#    define MACRO_PLAY_BURST 8 // max. počet událostí přehraných v jednom průchodu smyčkou
+#endif
+
+typedef enum {
+    MACRO_IDLE,
+    MACRO_RECORDING,
+    MACRO_FINISHING, // dopisuje zbytek bufferu a hlavičku do flash
+    MACRO_PLAYING,
+} macro_state_t;
+
+void macro_recorder_toggle_record(void);
+void macro_recorder_play(bool compressed); // compressed = bez prodlev mezi událostmi
+void process_macro_recorder(uint16_t keycode, keyrecord_t *record); // jen zaznamenává, událost nikdy nepohltí
+void macro_recorder_task(void);
+
+macro_state_t macro_recorder_state(void);
+uint16_t      macro_recorder_length(void); // počet událostí uloženého makra
@@ -0,0 +1,195 @@
+#include QMK_KEYBOARD_H
+
+#include "hal.h"
+#include "hardware/regs/intctrl.h"
+
+#include "matrix_sampler.h"
+#include "timing.h"
+
+// Vlastní matice (CUSTOM_MATRIX = lite): matici vzorkuje přerušení od alarmu časovače
+// v pevném taktu, debounce počítá ve vzorcích a každý nový stav po debounce uloží
+// i s časem do kruhového bufferu. Hlavní smyčka v matrix_scan_custom odebere jeden
+// snímek na průchod, takže pořadí změn i debounce nezávisí na tom, jak dlouho smyčka
+// trvá (zápis do flash, odesílání na displej).
+// Ring má jednoho zapisovatele (přerušení) a jednoho čtenáře (smyčka): head posouvá
+// jen přerušení, tail jen smyčka, takže zámky nejsou potřeba.
+
+#define PERIOD_US (1000000UL / MATRIX_SAMPLER_HZ)
+#define RING_SIZE 16 // mocnina dvou
+#define ALARM_IRQ (TIMER_IRQ_0 + MATRIX_SAMPLER_ALARM)
+#define ALARM_VECTOR Vector4C // TIMER_IRQ_3 ve vektorové tabulce RP2040
+
+_Static_assert(MATRIX_SAMPLER_ALARM == 3, "ALARM_VECTOR odpovídá alarmu 3");
+
+typedef struct {
+    uint32_t     time_us;
+    matrix_row_t rows[MATRIX_ROWS];
+} snapshot_t;
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static snapshot_t       ring[RING_SIZE];
+static volatile uint8_t head = 0;
+static volatile uint8_t tail = 0;
+
+static matrix_row_t     debounced[MATRIX_ROWS];
+static uint8_t          counters[MATRIX_ROWS][MATRIX_COLS];
+static volatile uint8_t threshold    = MATRIX_SAMPLER_DEBOUNCE * MATRIX_SAMPLER_HZ / 1000;
+static matrix_row_t     unpushed[MATRIX_ROWS]; // klávesy změněné od posledního uloženého snímku
+static bool             push_pending = false; // změna čeká na místo v ringu
+static uint32_t         next_alarm   = 0;
+static uint32_t         event_us     = 0;
+
+static matrix_sampler_stats_t stats;
+
+// Pevné ustálení místo matrix_output_select_delay()/unselect_delay(): ty čekají
+// desítky µs (MATRIX_IO_DELAY) a se třemi řádky by přerušení stálo ~90 µs z každých
+// 250 µs. Matice 3x4 má krátké spoje, řádek se výběrem stáhne v řádu desítek ns.
+// Po přečtení se řádek na chvíli aktivně nastaví do log. 1, aby spoj nedobíjel
+// jen pull-up, pak se vrátí na vstup s pull-upem.
+static inline void settle(void) {
+    for (uint8_t i = 0; i < MATRIX_SAMPLER_SETTLE_NOPS; i++) {
+        __NOP();
+    }
+}
+
+static void push(uint32_t time_us) {
+    uint8_t next = (head + 1) & (RING_SIZE - 1);
+
+    if (next == tail) { // smyčka nestíhá: stav se pošle, až bude místo, změny různých kláves se spojí
+        if (!push_pending) stats.overflows++;
+        push_pending = true;
+        return;
+    }
+
+    ring[head].time_us = time_us;
+    memcpy(ring[head].rows, debounced, sizeof(debounced));
+    __DMB(); // obsah snímku musí být vidět dřív než nový head
+    head         = next;
+    push_pending = false;
+    memset(unpushed, 0, sizeof(unpushed));
+    stats.snapshots++;
+}
+
+static void sample(void) {
+    uint32_t start   = timing_us();
+    bool     changed = false;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        gpio_set_pin_output(row_pins[row]);
+        gpio_write_pin_low(row_pins[row]);
+        settle();
+
+        matrix_row_t raw = 0;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (!gpio_read_pin(col_pins[col])) raw |= (matrix_row_t)1 << col;
+        }
+
+        gpio_write_pin_high(row_pins[row]);
+        settle();
+        gpio_set_pin_input_high(row_pins[row]);
+
+        matrix_row_t diff = raw ^ debounced[row];
+
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            matrix_row_t bit = (matrix_row_t)1 << col;
+
+            if (!(diff & bit)) {
+                counters[row][col] = 0;
+            } else if (++counters[row][col] >= threshold) {
+                if (unpushed[row] & bit) { // druhá změna téže klávesy by stisk s puštěním slila, počká na místo v ringu
+                    counters[row][col] = threshold;
+                    stats.held_changes++;
+                    continue;
+                }
+                debounced[row] ^= bit;
+                unpushed[row] |= bit;
+                counters[row][col] = 0;
+                changed            = true;
+            }
+        }
+    }
+
+    if (changed || push_pending) push(start);
+
+    stats.samples++;
+    uint32_t spent = timing_us() - start;
+    if (spent > stats.isr_max_us) stats.isr_max_us = spent;
+}
+
+OSAL_IRQ_HANDLER(ALARM_VECTOR) {
+    OSAL_IRQ_PROLOGUE();
+
+    timer_hw->intr = 1u << MATRIX_SAMPLER_ALARM;
+
+    next_alarm += PERIOD_US; // pevný takt bez driftu
+    if ((int32_t)(next_alarm - timer_hw->timerawl) <= 0) { // alarm v minulosti by přišel až po přetečení
+        next_alarm = timer_hw->timerawl + PERIOD_US;
+        stats.late_alarms++;
+    }
+    timer_hw->alarm[MATRIX_SAMPLER_ALARM] = next_alarm;
+
+    sample();
+
+    OSAL_IRQ_EPILOGUE();
+}
+
+void matrix_sampler_start(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        gpio_set_pin_input_high(row_pins[row]);
+    }
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        gpio_set_pin_input_high(col_pins[col]);
+    }
+
+    next_alarm = timer_hw->timerawl + PERIOD_US;
+    timer_hw->alarm[MATRIX_SAMPLER_ALARM] = next_alarm;
+    timer_hw->inte |= 1u << MATRIX_SAMPLER_ALARM;
+    nvicEnableVector(ALARM_IRQ, RP_IRQ_TIMER_ALARM3_PRIORITY);
+}
+
+void matrix_sampler_stop(void) {
+    nvicDisableVector(ALARM_IRQ);
+    timer_hw->inte &= ~(1u << MATRIX_SAMPLER_ALARM);
+    timer_hw->armed = 1u << MATRIX_SAMPLER_ALARM; // zápis 1 alarm zruší
+    timer_hw->intr  = 1u << MATRIX_SAMPLER_ALARM;
+}
+
+void matrix_sampler_set_debounce(uint8_t ms) {
+    uint32_t samples = (uint32_t)ms * MATRIX_SAMPLER_HZ / 1000;
+
+    threshold = samples < 1 ? 1 : samples > 255 ? 255 : samples;
+}
+
+uint32_t matrix_sampler_event_us(void) {
+    return event_us;
+}
+
+void matrix_init_custom(void) {
+    matrix_sampler_set_debounce(MATRIX_SAMPLER_DEBOUNCE);
+    matrix_sampler_start();
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+    uint8_t index = tail;
+
+    if (index == head) return false;
+
+    __DMB(); // číst snímek až po head, který ho zveřejnil
+
+    const snapshot_t *snapshot = &ring[index];
+
+    memcpy(current_matrix, snapshot->rows, sizeof(snapshot->rows));
+    event_us = snapshot->time_us;
+
+    tail = (index + 1) & (RING_SIZE - 1);
+
+    stats.latency_last_us = timing_us() - event_us;
+    if (stats.latency_last_us > stats.latency_max_us) stats.latency_max_us = stats.latency_last_us;
+    return true;
+}
+
+const matrix_sampler_stats_t *matrix_sampler_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef MATRIX_SAMPLER_HZ
+#    define MATRIX_SAMPLER_HZ 4000 // vzorkování matice z alarmu časovače
+#endif
+#ifndef MATRIX_SAMPLER_DEBOUNCE
+#    define MATRIX_SAMPLER_DEBOUNCE 5 // ms stabilního stavu, než se změna klávesy přijme
+#endif
+#ifndef MATRIX_SAMPLER_SETTLE_NOPS
+#    define MATRIX_SAMPLER_SETTLE_NOPS 48 // ustálení řádku v přerušení, ~0,4 µs při 125 MHz
+#endif
+#ifndef MATRIX_SAMPLER_ALARM
+#    define MATRIX_SAMPLER_ALARM 3 // alarm 0 používá ChibiOS pro systémový čas
+#endif
+
+typedef struct {
+    uint32_t samples;
+    uint32_t snapshots;       // změny po debounce předané hlavní smyčce
+    uint32_t overflows;       // plný ring, změny různých kláves se sloučily do jednoho snímku
+    uint32_t held_changes;    // vzorky, kdy změna klávesy čekala, až se uloží její předchozí změna
+    uint32_t late_alarms;     // vzorek se nestihl v termínu, takt se znovu srovnal
+    uint32_t isr_max_us;
+    uint32_t latency_last_us; // vzorek -> zpracování v matrix_scan
+    uint32_t latency_max_us;
+} matrix_sampler_stats_t;
+
+void matrix_sampler_start(void);
+void matrix_sampler_stop(void); // např. před spánkem, řádky pak patří idle_sleep
+
+void matrix_sampler_set_debounce(uint8_t ms);
+
+uint32_t matrix_sampler_event_us(void); // čas vzorku, ze kterého pochází právě zpracovávaná změna (timing_us)
+
+const matrix_sampler_stats_t *matrix_sampler_stats(void);
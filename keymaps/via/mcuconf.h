@@ -98,7 +98,7 @@
   */
  #define RP_I2C_USE_I2C0                 FALSE
  #define RP_I2C_USE_I2C1                 TRUE   // *** TOTO JE JEDINÁ ZMĚNA, kterou jsme udělali ***
- #define RP_I2C_BUSY_TIMEOUT             50
+ #define RP_I2C_BUSY_TIMEOUT             5      // zaseknutá sběrnice nesmí zdržet smyčku, obnovu řeší oled_i2c.c
  #define RP_I2C_ADDRESS_MODE_10BIT       FALSE
  
  /*
@@ -0,0 +1,133 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_anim.h"
+#include "oled_fb.h"
+#include "ram_watch.h"
+#include "timing.h"
+
+// Přechody mezi obrázky vrstev. Sloupec displeje 128x32 jsou přesně 4 stránky po 8 bitech,
+// tedy jedno 32bitové slovo, takže svislý posun i stírání jsou jen posun a maska slova.
+// Plánovač v každém volání skládá a odesílá stránky, dokud se další krok vejde do
+// OLED_ANIM_BUDGET_US (podle nejhoršího naměřeného času kroku) a OLED_ANIM_MAX_PAGES.
+
+static uint8_t          from[OLED_FB_SIZE]; // snímek před přechodem
+RAM_ACCOUNT(sizeof(from), OLED_ANIM_RAM);
+static const uint8_t   *target   = NULL;    // cílový snímek v RAM (oled_prefetch)
+static oled_anim_kind_t kind     = OLED_ANIM_SLIDE;
+static uint8_t          frame    = 0;       // 1..OLED_ANIM_FRAMES, 0 = neběží
+static uint8_t          next_page = 0;      // další stránka ke složení v aktuálním snímku
+static bool             draining  = false;  // poslední snímek přechodu je ještě na sběrnici
+
+static uint32_t compose_cost_us = 0; // nejhorší naměřený čas složení stránky
+static uint32_t send_cost_us    = 0; // nejhorší naměřený čas odeslání stránky
+
+static oled_anim_stats_t stats;
+
+static inline uint32_t column(const uint8_t *buf, uint8_t x) {
+    return (uint32_t)buf[x] | (uint32_t)buf[OLED_FB_WIDTH + x] << 8 | (uint32_t)buf[2 * OLED_FB_WIDTH + x] << 16 | (uint32_t)buf[3 * OLED_FB_WIDTH + x] << 24;
+}
+
+static void compose_page(uint8_t page, uint8_t *out) {
+    uint8_t shift = page * 8;
+
+    switch (kind) {
+        case OLED_ANIM_SLIDE: {
+            uint8_t offset = (uint16_t)frame * OLED_FB_WIDTH / OLED_ANIM_FRAMES;
+
+            for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) {
+                uint16_t src = x + offset;
+                out[x] = src < OLED_FB_WIDTH ? from[page * OLED_FB_WIDTH + src] : target[page * OLED_FB_WIDTH + src - OLED_FB_WIDTH];
+            }
+            break;
+        }
+
+        case OLED_ANIM_LIFT: {
+            uint8_t k = (uint16_t)frame * 32 / OLED_ANIM_FRAMES;
+
+            for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) {
+                uint32_t word = k >= 32 ? column(target, x) : (column(from, x) >> k) | (k ? column(target, x) << (32 - k) : 0);
+                out[x]        = word >> shift;
+            }
+            break;
+        }
+
+        case OLED_ANIM_WIPE: {
+            uint8_t  k    = (uint16_t)frame * 32 / OLED_ANIM_FRAMES;
+            uint32_t mask = k >= 32 ? UINT32_MAX : ((uint32_t)1 << k) - 1; // horních k řádků už je nových
+
+            for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) {
+                uint32_t word = (column(target, x) & mask) | (column(from, x) & ~mask);
+                out[x]        = word >> shift;
+            }
+            break;
+        }
+    }
+}
+
+void oled_anim_start(oled_anim_kind_t anim, const uint8_t *image) {
+    memcpy(from, oled_fb_front(), OLED_FB_SIZE);
+    target    = image;
+    kind      = anim;
+    frame     = 1;
+    next_page = 0;
+    draining  = false;
+    stats.animations++;
+}
+
+bool oled_anim_active(void) { // rozeslané snímky jiných modulů (oled_gray) si dokončují samy
+    if (draining && !oled_fb_busy()) draining = false;
+    return frame != 0 || draining;
+}
+
+void oled_anim_task(void) {
+    uint32_t start = timing_us();
+    uint8_t  pages = 0;
+
+    while (pages < OLED_ANIM_MAX_PAGES) {
+        uint32_t elapsed = timing_us() - start;
+
+        if (oled_fb_busy()) {
+            if (pages && elapsed + send_cost_us > OLED_ANIM_BUDGET_US) break;
+
+            uint32_t t = timing_us();
+            oled_fb_flush(1);
+            t = timing_us() - t;
+            if (t > send_cost_us) send_cost_us = t;
+            pages++;
+            continue;
+        }
+
+        if (frame == 0) break;
+
+        if (next_page < OLED_FB_PAGES) {
+            if (pages && elapsed + compose_cost_us > OLED_ANIM_BUDGET_US) break;
+
+            uint32_t t = timing_us();
+            compose_page(next_page, oled_fb_back() + next_page * OLED_FB_WIDTH);
+            t = timing_us() - t;
+            if (t > compose_cost_us) compose_cost_us = t;
+            next_page++;
+            pages++;
+            continue;
+        }
+
+        // snímek je složený, předáme ho k odeslání
+        oled_fb_swap();
+        next_page = 0;
+        if (++frame > OLED_ANIM_FRAMES) {
+            frame    = 0;
+            draining = true;
+        }
+    }
+
+    uint32_t spent = timing_us() - start;
+
+    stats.ticks++;
+    stats.last_tick_us = spent;
+    if (spent > stats.max_tick_us) stats.max_tick_us = spent;
+    if (spent > OLED_ANIM_BUDGET_US) stats.over_budget++;
+}
+
+const oled_anim_stats_t *oled_anim_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OLED_ANIM_RAM OLED_FB_SIZE // snímek před přechodem
+
+#ifndef OLED_ANIM_FRAMES
+#    define OLED_ANIM_FRAMES 8 // počet snímků přechodu
+#endif
+#ifndef OLED_ANIM_BUDGET_US
+#    define OLED_ANIM_BUDGET_US 4000 // nejvíc času, které animace přidá jednomu volání oled_task_user
+#endif
+#ifndef OLED_ANIM_MAX_PAGES
+#    define OLED_ANIM_MAX_PAGES 2 // nejvíc složených + odeslaných stránek na jedno volání
+#endif
+
+typedef enum {
+    OLED_ANIM_SLIDE, // nový obrázek přijede zprava
+    OLED_ANIM_LIFT,  // nový obrázek vyjede zdola (posun 32bitových sloupců)
+    OLED_ANIM_WIPE,  // nový obrázek se odkrývá shora dolů
+} oled_anim_kind_t;
+
+typedef struct {
+    uint32_t animations;
+    uint32_t ticks;
+    uint32_t last_tick_us;
+    uint32_t max_tick_us;
+    uint32_t over_budget; // volání, která rozpočet překročila (jen když byl odhad nákladů malý)
+} oled_anim_stats_t;
+
+void oled_anim_start(oled_anim_kind_t kind, const uint8_t *target); // z aktuálního snímku na snímek v RAM (musí platit až do konce)
+bool oled_anim_active(void);
+void oled_anim_task(void); // volat z oled_task_user místo oled_fb_commit, dokud animace běží
+
+const oled_anim_stats_t *oled_anim_stats(void);
@@ -0,0 +1,147 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_fb.h"
+#include "oled_i2c.h"
+#include "ram_watch.h"
+#include "timing.h"
+#include "trace.h"
+
+// Dvojitý buffer: oled_task_user skládá snímek do zadního bufferu a oled_fb_commit()
+// ho atomicky prohodí s předním. Transport posílá vždy jen přední (hotový) snímek,
+// a to celý v jednom volání, takže se na displeji nikdy nepotkají dva různé obrázky.
+// Bitmapa změněných stránek omezí přenos jen na stránky, které se opravdu liší.
+
+static uint8_t  buffers[2][OLED_FB_SIZE]; // ukazatele se mohou vyměnit s buffery oled_prefetch
+static uint8_t *front = buffers[0];
+static uint8_t *back  = buffers[1];
+static uint8_t  pending = 0; // stránky předního bufferu, které ještě nejsou na displeji
+
+static oled_orient_t orient = OLED_FB_ORIENTATION;
+
+static oled_fb_stats_t stats;
+
+uint8_t *oled_fb_back(void) {
+    return back;
+}
+
+const uint8_t *oled_fb_front(void) {
+    return front;
+}
+
+uint8_t *oled_fb_exchange_back(uint8_t *frame) {
+    uint8_t *old = back;
+
+    back = frame;
+    return old;
+}
+
+void oled_fb_load_P(const char *image) {
+    memcpy_P(back, image, OLED_FB_SIZE);
+}
+
+static bool send_page(uint8_t page) { // page = stránka snímku, při převrácení jde na opačnou stránku displeje
+    bool           flip   = orient == OLED_ORIENT_180 || orient == OLED_ORIENT_MIRROR_Y;
+    uint8_t        target = flip ? OLED_FB_PAGES - 1 - page : page;
+    const uint8_t *data   = front + target * OLED_FB_WIDTH;
+
+    if (orient != OLED_ORIENT_0) { // otočení/zrcadlení až na cestě na displej
+        static uint8_t rotated[OLED_FB_WIDTH];
+        RAM_ACCOUNT(sizeof(buffers) + sizeof(rotated), OLED_FB_RAM);
+
+        oled_rotate_page(orient, front, target, rotated);
+        data = rotated;
+    }
+
+    return oled_i2c_send_page(target, data); // celá stránka jedním přenosem, bez bufferu ovladače QMK
+}
+
+bool oled_fb_swap(void) {
+    if (pending) return false;
+
+    for (uint8_t page = 0; page < OLED_FB_PAGES; page++) {
+        if (memcmp(front + page * OLED_FB_WIDTH, back + page * OLED_FB_WIDTH, OLED_FB_WIDTH)) {
+            pending |= 1 << page;
+        }
+    }
+
+    if (!pending) {
+        stats.empty_commits++;
+        return false;
+    }
+
+    if (orient == OLED_ORIENT_90 || orient == OLED_ORIENT_270) {
+        pending = (1 << OLED_FB_PAGES) - 1; // stránka snímku na výšku zasahuje do všech stránek displeje
+    }
+
+    uint8_t *done = back;
+    back          = front;
+    front         = done;
+
+    // zadní buffer musí dál odpovídat hotovému snímku, aby šlo skládat jen změny
+    for (uint8_t page = 0; page < OLED_FB_PAGES; page++) {
+        if (pending & (1 << page)) {
+            memcpy(back + page * OLED_FB_WIDTH, front + page * OLED_FB_WIDTH, OLED_FB_WIDTH);
+        }
+    }
+
+    stats.commits++;
+    return true;
+}
+
+uint8_t oled_fb_flush(uint8_t max_pages) {
+    uint8_t  sent  = 0;
+    uint32_t start = timing_us();
+
+    if (pending && !is_oled_on()) {
+        oled_on(); // jako oled_render(): nový obsah displej probudí
+    }
+
+    for (uint8_t page = 0; page < OLED_FB_PAGES && sent < max_pages; page++) {
+        if (!(pending & (1 << page))) continue;
+
+        if (!send_page(page)) break; // stránka zůstane čekat, sběrnice se mezitím obnovila
+
+        pending &= ~(1 << page);
+        sent++;
+    }
+
+    if (sent) {
+        stats.pages_sent += sent;
+        stats.last_sent_us  = timing_us();
+        stats.last_flush_us = stats.last_sent_us - start;
+        TRACE(OLED_FLUSH, sent, stats.last_flush_us);
+    }
+    return sent;
+}
+
+bool oled_fb_busy(void) {
+    return pending != 0;
+}
+
+void oled_fb_resend(void) {
+    pending = (1 << OLED_FB_PAGES) - 1; // odejde s dalším flush, i když se snímek nezměnil
+}
+
+bool oled_fb_commit(void) {
+    oled_fb_flush(OLED_FB_PAGES); // případný rozpracovaný snímek nejdřív dokončit
+
+    if (!oled_fb_swap()) return false;
+
+    oled_fb_flush(OLED_FB_PAGES);
+    return true;
+}
+
+void oled_fb_set_orientation(oled_orient_t orientation) {
+    if (orientation >= OLED_ORIENT_COUNT || orientation == orient) return;
+
+    orient  = orientation;
+    pending = (1 << OLED_FB_PAGES) - 1; // celý hotový snímek znovu, už otočený
+}
+
+oled_orient_t oled_fb_orientation(void) {
+    return orient;
+}
+
+const oled_fb_stats_t *oled_fb_stats(void) {
+    return &stats;
+}
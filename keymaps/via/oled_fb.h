@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "oled_rotate.h"
+
+#ifndef OLED_FB_ORIENTATION
+#    define OLED_FB_ORIENTATION OLED_ORIENT_0 // orientace po startu
+#endif
+
+#define OLED_FB_WIDTH OLED_DISPLAY_WIDTH
+#define OLED_FB_PAGES (OLED_DISPLAY_HEIGHT / 8) // stránka SSD1306 = 8 řádků pixelů
+#define OLED_FB_SIZE (OLED_FB_WIDTH * OLED_FB_PAGES)
+#define OLED_FB_RAM (2 * OLED_FB_SIZE + OLED_FB_WIDTH) // přední a zadní buffer + otočená stránka na cestě na displej
+
+typedef struct {
+    uint32_t commits;       // snímky, které něco změnily
+    uint32_t empty_commits; // snímky beze změny (nic se neposílalo)
+    uint32_t pages_sent;
+    uint32_t last_flush_us; // doba odeslání posledního snímku
+    uint32_t last_sent_us;  // kdy skončilo poslední odesílání (µs od resetu)
+} oled_fb_stats_t;
+
+uint8_t       *oled_fb_back(void);               // zadní buffer pro skládání snímku, obsah = poslední hotový snímek
+const uint8_t *oled_fb_front(void);              // poslední hotový snímek
+void           oled_fb_load_P(const char *image); // zkopíruje celý 512B obrázek z PROGMEM do zadního bufferu
+bool           oled_fb_commit(void);             // prohodí buffery a hned odešle změněné stránky, true = něco se změnilo
+uint8_t       *oled_fb_exchange_back(uint8_t *frame); // vymění zadní buffer za hotový snímek (jen ukazatel), vrací starý buffer
+
+// Rozložené odesílání pro animace: oled_fb_swap() jen prohodí buffery a označí změněné
+// stránky, oled_fb_flush() jich pak pošle nejvýš max_pages. Dokud není předchozí snímek
+// celý odeslaný (oled_fb_busy), další se neprohodí, takže se míchají nejvýš dva po sobě
+// jdoucí snímky.
+bool    oled_fb_swap(void);
+uint8_t oled_fb_flush(uint8_t max_pages);
+bool    oled_fb_busy(void);
+void    oled_fb_resend(void); // obsah displeje je neplatný (např. po hardwarovém scrollu), celý snímek znovu
+
+// Orientace se uplatní při odesílání stránek, skládání snímků se nemění.
+void          oled_fb_set_orientation(oled_orient_t orientation);
+oled_orient_t oled_fb_orientation(void);
+
+const oled_fb_stats_t *oled_fb_stats(void);
@@ -0,0 +1,96 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_gray.h"
+#include "ram_watch.h"
+#include "timing.h"
+
+// Plánovač rovin jede přes oled_fb: rovina se zkopíruje do zadního bufferu a prohodí,
+// takže se posílají jen stránky, ve kterých se roviny liší, a odesílání se dělí mezi
+// průchody smyčkou po OLED_GRAY_MAX_PAGES stránkách. Výměny mají pevný takt; když je
+// předchozí rovina ještě na sběrnici, slot se započítá jako zmeškaný a čeká se.
+
+#define SLOT_US (1000000UL / OLED_GRAY_PLANE_HZ)
+
+static const uint8_t sequence[] = {OLED_GRAY_MSB, OLED_GRAY_MSB, OLED_GRAY_LSB}; // váhy 2:1
+
+static uint8_t  planes[2][OLED_FB_SIZE];
+RAM_ACCOUNT(sizeof(planes), OLED_GRAY_RAM);
+static bool     active       = false;
+static uint8_t  step         = 0;
+static uint32_t next_slot    = 0;
+static uint32_t window_start = 0;
+static uint32_t window_busy  = 0; // µs odesílání v aktuálním okně
+
+static oled_gray_stats_t stats;
+
+static void start(void) {
+    active       = true;
+    step         = 0;
+    next_slot    = timing_us();
+    window_start = next_slot;
+    window_busy  = 0;
+}
+
+void oled_gray_load_P(const oled_gray_image_t *image) {
+    memcpy_P(planes, image->planes, sizeof(planes));
+    start();
+}
+
+void oled_gray_start_dimmed(const uint8_t *image) {
+    memcpy(planes[OLED_GRAY_LSB], image, OLED_FB_SIZE);
+    memset(planes[OLED_GRAY_MSB], 0, OLED_FB_SIZE);
+    start();
+}
+
+uint8_t *oled_gray_plane(uint8_t plane) {
+    return planes[plane & 1];
+}
+
+void oled_gray_stop(void) {
+    active = false;
+}
+
+bool oled_gray_active(void) {
+    return active;
+}
+
+void oled_gray_task(void) {
+    if (!active || !is_oled_on()) return; // vypnutý displej (OLED_TIMEOUT) nic nedostává
+
+    uint32_t begin = timing_us();
+
+    if ((int32_t)(begin - next_slot) >= 0) { // čas na další rovinu
+        if (oled_fb_busy()) {
+            stats.missed_slots++;
+        } else {
+            memcpy(oled_fb_back(), planes[sequence[step]], OLED_FB_SIZE);
+            oled_fb_swap();
+            stats.planes_shown++;
+
+            if (++step >= sizeof(sequence)) step = 0;
+            next_slot += SLOT_US;
+            if ((int32_t)(begin - next_slot) >= 0) next_slot = begin + SLOT_US; // po zaseknutí nedohánět
+        }
+    }
+
+    uint8_t sent = oled_fb_flush(OLED_GRAY_MAX_PAGES);
+    if (sent) {
+        stats.pages_sent += sent;
+        window_busy += oled_fb_stats()->last_flush_us;
+    }
+
+    uint32_t end = timing_us();
+
+    if (end - window_start >= 1000000UL) {
+        stats.bus_permille = window_busy / ((end - window_start) / 1000);
+        window_start       = end;
+        window_busy        = 0;
+    }
+
+    stats.task_last_us = end - begin;
+    if (stats.task_last_us > stats.task_max_us) stats.task_max_us = stats.task_last_us;
+}
+
+const oled_gray_stats_t *oled_gray_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "oled_fb.h"
+
+#ifndef OLED_GRAY_PLANE_HZ
+#    define OLED_GRAY_PLANE_HZ 180 // výměn bitových rovin za sekundu (3 roviny = 60 Hz cyklus)
+#endif
+#ifndef OLED_GRAY_MAX_PAGES
+#    define OLED_GRAY_MAX_PAGES 2 // nejvíc odeslaných stránek na jedno volání oled_gray_task
+#endif
+
+// Odstíny šedi střídáním rovin: pixel se 2bitovou hodnotou v = 2*MSB + LSB svítí
+// v sekvenci MSB, MSB, LSB po dobu v/3 cyklu -> úrovně 0, 1/3, 2/3, plný jas.
+#define OLED_GRAY_LSB 0
+#define OLED_GRAY_MSB 1
+
+#define OLED_GRAY_RAM (2 * OLED_FB_SIZE) // bitové roviny
+
+typedef struct {
+    uint8_t planes[2][OLED_FB_SIZE]; // formát stránek SSD1306, [OLED_GRAY_LSB], [OLED_GRAY_MSB]
+} oled_gray_image_t;
+
+typedef struct {
+    uint32_t planes_shown;
+    uint32_t missed_slots;   // výměna roviny se nestihla, předchozí byla ještě na sběrnici
+    uint32_t pages_sent;
+    uint16_t bus_permille;   // obsazení sběrnice za poslední okno (‰ času odesíláním)
+    uint32_t task_last_us;   // náklad jednoho volání oled_gray_task v hlavní smyčce
+    uint32_t task_max_us;
+} oled_gray_stats_t;
+
+void     oled_gray_load_P(const oled_gray_image_t *image); // 2bitový obrázek z PROGMEM
+void     oled_gray_start_dimmed(const uint8_t *image);     // jednobitový obrázek na 1/3 jasu
+uint8_t *oled_gray_plane(uint8_t plane);                   // pro kreslení přímo do roviny
+void     oled_gray_stop(void);
+bool     oled_gray_active(void);
+void     oled_gray_task(void); // volat z oled_task_user místo oled_fb_commit, dokud je aktivní
+
+const oled_gray_stats_t *oled_gray_stats(void);
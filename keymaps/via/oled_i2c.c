@@ -0,0 +1,167 @@
+#include QMK_KEYBOARD_H
+
+#include "i2c_master.h"
+#include "oled_i2c.h"
+#include "ram_watch.h"
+#include "timing.h"
+
+// Vlastní přenos stránek pro SSD1306: jedna transakce s adresou stránky a jedna
+// se 128 bajty dat, místo bloků přes buffer ovladače QMK. Chyby se počítají,
+// po OLED_I2C_FALLBACK_ERRORS chybách po sobě se sběrnice zpomalí a zaseknutý
+// slave se uvolní ručním taktováním SCL. Posílá se přímo přes ChibiOS
+// i2cMasterTransmitTimeout: i2c_transmit z QMK volá před každým přenosem
+// i2cStart se svou konfigurací (I2C1_CLOCK_SPEED) a rychlost by přepsal. Ovladač
+// OLED z QMK tak dál dělá (init, zapnutí displeje), proto se před přenosem
+// kontroluje, jestli je v ovladači pořád nastavená konfigurace tohoto modulu.
+
+#define SSD1306_ADDRESS OLED_DISPLAY_ADDRESS // ChibiOS chce 7bitovou adresu
+#define SSD1306_CONTROL_COMMAND 0x00
+#define SSD1306_CONTROL_DATA 0x40
+
+static I2CConfig config        = {.baudrate = OLED_I2C_FAST_HZ};
+static bool      applied       = false; // false = rychlost se změnila, restartovat ovladač
+static uint8_t   error_streak  = 0;
+static uint32_t  last_error_ms = 0;
+
+static oled_i2c_stats_t stats;
+
+static void apply(void) {
+    i2cStop(&I2C_DRIVER);
+    i2cStart(&I2C_DRIVER, &config);
+    applied        = true;
+    stats.clock_hz = config.baudrate;
+}
+
+void oled_i2c_set_fast(bool fast) {
+    config.baudrate = fast ? OLED_I2C_FAST_HZ : OLED_I2C_SAFE_HZ;
+    applied         = false;
+}
+
+void oled_i2c_recover(void) {
+    i2cStop(&I2C_DRIVER);
+
+    // SDA drží slave uprostřed bajtu: až 9 hodin SCL, dokud SDA nepustí, pak STOP
+    gpio_set_pin_input_high(I2C_SDA_PIN);
+    gpio_set_pin_output_open_drain(I2C_SCL_PIN);
+    gpio_write_pin_high(I2C_SCL_PIN);
+    wait_us(5);
+
+    for (uint8_t i = 0; i < 9 && !gpio_read_pin(I2C_SDA_PIN); i++) {
+        gpio_write_pin_low(I2C_SCL_PIN);
+        wait_us(5);
+        gpio_write_pin_high(I2C_SCL_PIN);
+        wait_us(5);
+    }
+
+    gpio_set_pin_output_open_drain(I2C_SDA_PIN); // STOP: SDA nahoru, zatímco SCL je nahoře
+    gpio_write_pin_low(I2C_SDA_PIN);
+    wait_us(5);
+    gpio_write_pin_high(I2C_SDA_PIN);
+    wait_us(5);
+
+    palSetLineMode(I2C_SCL_PIN, PAL_MODE_ALTERNATE_I2C | PAL_RP_PAD_SLEWFAST | PAL_RP_PAD_PUE | PAL_RP_PAD_DRIVE4);
+    palSetLineMode(I2C_SDA_PIN, PAL_MODE_ALTERNATE_I2C | PAL_RP_PAD_SLEWFAST | PAL_RP_PAD_PUE | PAL_RP_PAD_DRIVE4);
+
+    stats.recoveries++;
+    applied = false;
+}
+
+static void handle_error(i2c_status_t status) {
+    if (status == I2C_STATUS_TIMEOUT) {
+        stats.timeouts++;
+    } else {
+        stats.errors++;
+    }
+    last_error_ms = timer_read32();
+
+    bool streak = ++error_streak >= OLED_I2C_FALLBACK_ERRORS;
+
+    if (streak && config.baudrate != OLED_I2C_SAFE_HZ) {
+        config.baudrate = OLED_I2C_SAFE_HZ;
+        stats.fallbacks++;
+    }
+
+    if (status == I2C_STATUS_TIMEOUT || streak) {
+        oled_i2c_recover(); // po timeoutu je stav sběrnice neznámý
+        error_streak = 0;
+    }
+    applied = false;
+}
+
+static void ensure_applied(void) {
+    if (!applied || I2C_DRIVER.config != &config) apply(); // mezitím i2cStart z QMK
+}
+
+static i2c_status_t transfer(const uint8_t *data, uint16_t length) {
+    msg_t        result = i2cMasterTransmitTimeout(&I2C_DRIVER, SSD1306_ADDRESS, data, length, NULL, 0, TIME_MS2I(OLED_I2C_TIMEOUT_MS));
+    i2c_status_t status = result == MSG_OK ? I2C_STATUS_SUCCESS : result == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
+
+    if (status == I2C_STATUS_SUCCESS) {
+        stats.transfers++;
+        stats.bytes += length;
+    }
+    return status;
+}
+
+bool oled_i2c_send_page(uint8_t page, const uint8_t *data) {
+    static uint8_t packet[1 + OLED_DISPLAY_WIDTH] = {SSD1306_CONTROL_DATA};
+    RAM_ACCOUNT(sizeof(packet), OLED_I2C_RAM);
+
+    if (config.baudrate != OLED_I2C_FAST_HZ && timer_elapsed32(last_error_ms) >= OLED_I2C_RETRY_FAST_MS) {
+        oled_i2c_set_fast(true); // dlouho bez chyby, zkusit zase rychlý profil
+    }
+
+    const uint8_t address[] = {
+        SSD1306_CONTROL_COMMAND,
+        0x21, 0, OLED_DISPLAY_WIDTH - 1, // rozsah sloupců
+        0x22, page, page,                // rozsah stránek
+    };
+
+    memcpy(packet + 1, data, OLED_DISPLAY_WIDTH);
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        ensure_applied();
+
+        uint32_t     start  = timing_us();
+        i2c_status_t status = transfer(address, sizeof(address));
+
+        if (status == I2C_STATUS_SUCCESS) status = transfer(packet, sizeof(packet));
+
+        if (status == I2C_STATUS_SUCCESS) {
+            error_streak       = 0;
+            stats.last_page_us = timing_us() - start;
+            if (stats.last_page_us > stats.max_page_us) stats.max_page_us = stats.last_page_us;
+            return true;
+        }
+
+        handle_error(status);
+    }
+    return false;
+}
+
+bool oled_i2c_send_commands(const uint8_t *commands, uint8_t length) {
+    uint8_t packet[1 + OLED_I2C_MAX_COMMANDS] = {SSD1306_CONTROL_COMMAND};
+
+    if (length > OLED_I2C_MAX_COMMANDS) return false;
+
+    memcpy(packet + 1, commands, length);
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        ensure_applied();
+
+        i2c_status_t status = transfer(packet, 1 + length);
+
+        if (status == I2C_STATUS_SUCCESS) {
+            error_streak = 0;
+            stats.command_transfers++;
+            return true;
+        }
+
+        handle_error(status);
+    }
+    return false;
+}
+
+const oled_i2c_stats_t *oled_i2c_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef OLED_I2C_FAST_HZ
+#    define OLED_I2C_FAST_HZ 1000000 // Fast-mode Plus
+#endif
+#ifndef OLED_I2C_SAFE_HZ
+#    define OLED_I2C_SAFE_HZ 400000 // Fast-mode, záložní profil
+#endif
+#ifndef OLED_I2C_TIMEOUT_MS
+#    define OLED_I2C_TIMEOUT_MS 5 // stránka (129 B) trvá i při 400 kHz ~3 ms
+#endif
+#ifndef OLED_I2C_FALLBACK_ERRORS
+#    define OLED_I2C_FALLBACK_ERRORS 2 // chyby po sobě, po kterých se přejde na pomalejší profil
+#endif
+#ifndef OLED_I2C_MAX_COMMANDS
+#    define OLED_I2C_MAX_COMMANDS 8 // nejdelší řada příkazů v jedné transakci
+#endif
+#ifndef OLED_I2C_RETRY_FAST_MS
+#    define OLED_I2C_RETRY_FAST_MS 60000 // po této době bez chyby se zkusí zase rychlý profil
+#endif
+
+#define OLED_I2C_RAM (1 + OLED_DISPLAY_WIDTH) // řídicí bajt + stránka
+
+typedef struct {
+    uint32_t clock_hz;        // rychlost nastavená v ovladači, 0 = zatím nic neodešlo
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t command_transfers; // samotné příkazy řadiče (oled_i2c_send_commands)
+    uint32_t errors;          // NACK a jiné chyby přenosu
+    uint32_t timeouts;
+    uint32_t recoveries;      // uvolnění zaseknuté sběrnice (9 hodin SCL + STOP)
+    uint32_t fallbacks;       // přechody na pomalejší profil
+    uint32_t last_page_us;    // doba odeslání poslední stránky
+    uint32_t max_page_us;
+} oled_i2c_stats_t;
+
+// Pošle jednu stránku (128 B) SSD1306 přímo po I2C, při chybě sběrnici obnoví,
+// případně zpomalí a jednou to zkusí znovu. false = stránka neodešla.
+bool oled_i2c_send_page(uint8_t page, const uint8_t *data);
+
+// Pošle řadu příkazů SSD1306 (kontrast, offset, scroll...) jednou transakcí,
+// se stejnou obnovou po chybě jako stránky. false = příkazy neodešly.
+bool oled_i2c_send_commands(const uint8_t *commands, uint8_t length);
+
+void oled_i2c_set_fast(bool fast); // profil OLED_I2C_FAST_HZ / OLED_I2C_SAFE_HZ
+void oled_i2c_recover(void);
+
+const oled_i2c_stats_t *oled_i2c_stats(void);
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stdint.h>
+
+#define OLED_IMAGE_LAYERS 4 // vrstvy s vlastním obrázkem
+#define OLED_IMAGE_DESIGNS 4 // počet designů, přepíná KC_DISPLAY_DESIGN
+
+const char *oled_image(uint8_t layer, uint8_t design); // 128x32 obrázek v pořadí stránek SSD1306 (512 B, PROGMEM)
@@ -0,0 +1,227 @@
+#include QMK_KEYBOARD_H
+
+#include "via.h"
+#include "keymap_user.h"
+#include "key_index.h"
+#include "oled_fb.h"
+#include "oled_text.h"
+#include "oled_legend.h"
+
+// Mřížka: stránka 0 = nadpis, stránky 1-3 = řádky matice, každá klávesa má 4 znaky
+// a mezeru, sloupec matice c začíná na znaku c * 5 + 1 (20 znaků + okraj = 21).
+
+#define CELL_CHARS 4
+#define CELL_PITCH (CELL_CHARS + 1)
+
+typedef struct {
+    uint16_t keycode;
+    char     label[CELL_CHARS]; // bez '\0', kratší popisky doplněné nulami
+} legend_label_t;
+
+// jen keycody, které nejdou odvodit výpočtem (písmena, číslice, F-klávesy)
+static const legend_label_t PROGMEM label_table[] = {
+    {KC_NO, ""},
+    {KC_TRNS, "--"},
+    {KC_ENTER, "Ent"},
+    {KC_ESCAPE, "Esc"},
+    {KC_BACKSPACE, "Bspc"},
+    {KC_TAB, "Tab"},
+    {KC_SPACE, "Spc"},
+    {KC_MINUS, "-"},
+    {KC_EQUAL, "="},
+    {KC_CAPS_LOCK, "Caps"},
+    {KC_PRINT_SCREEN, "PScr"},
+    {KC_INSERT, "Ins"},
+    {KC_HOME, "Home"},
+    {KC_PAGE_UP, "PgUp"},
+    {KC_DELETE, "Del"},
+    {KC_END, "End"},
+    {KC_PAGE_DOWN, "PgDn"},
+    {KC_RIGHT, "Rght"},
+    {KC_LEFT, "Left"},
+    {KC_DOWN, "Down"},
+    {KC_UP, "Up"},
+    {KC_AUDIO_MUTE, "Mute"},
+    {KC_AUDIO_VOL_UP, "Vol+"},
+    {KC_AUDIO_VOL_DOWN, "Vol-"},
+    {KC_MEDIA_NEXT_TRACK, "Next"},
+    {KC_MEDIA_PREV_TRACK, "Prev"},
+    {KC_MEDIA_PLAY_PAUSE, "Play"},
+    {KC_LEFT_CTRL, "Ctl"},
+    {KC_LEFT_SHIFT, "Sft"},
+    {KC_LEFT_ALT, "Alt"},
+    {KC_LEFT_GUI, "Gui"},
+    {KC_RIGHT_CTRL, "RCtl"},
+    {KC_RIGHT_SHIFT, "RSft"},
+    {KC_RIGHT_ALT, "RAlt"},
+    {KC_RIGHT_GUI, "RGui"},
+    {QK_BOOT, "Boot"},
+    {QK_HAPTIC_RESET, "HRst"},
+    {QK_HAPTIC_DWELL_UP, "Dw+"},
+    {QK_HAPTIC_DWELL_DOWN, "Dw-"},
+    {KC_CYCLE_LAYERS, "Cyc"},
+    {KC_DISPLAY_DESIGN, "Dsgn"},
+    {KC_MACRO_REC, "MRec"},
+    {KC_MACRO_PLAY, "MPly"},
+    {KC_MACRO_PLAY_FAST, "MFst"},
+    {KC_PROFILE_NEXT, "Prof"},
+};
+
+static uint16_t shown[KEY_COUNT]; // keycody, které jsou v mřížce vykreslené
+static uint8_t  shown_layer = 0xFF;
+static bool     cleared     = false; // buffer obsahuje prázdnou mřížku s nadpisem
+static bool     stale       = true;  // keymapa se mohla změnit, přečíst znovu
+
+static oled_legend_stats_t stats;
+
+static void put_hex(char *dst, uint16_t value, uint8_t digits) {
+    for (int8_t i = digits - 1; i >= 0; i--) {
+        uint8_t nibble = value & 0xF;
+        dst[i]         = nibble < 10 ? '0' + nibble : 'A' + nibble - 10;
+        value >>= 4;
+    }
+}
+
+static bool basic_label(uint8_t keycode, char *dst) { // dst má místo na 4 znaky
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        dst[0] = 'A' + keycode - KC_A;
+        return true;
+    }
+    if (keycode >= KC_1 && keycode <= KC_0) {
+        dst[0] = keycode == KC_0 ? '0' : '1' + keycode - KC_1;
+        return true;
+    }
+    if ((keycode >= KC_F1 && keycode <= KC_F12) || (keycode >= KC_F13 && keycode <= KC_F24)) {
+        uint8_t n = keycode <= KC_F12 ? keycode - KC_F1 + 1 : keycode - KC_F13 + 13;
+        dst[0]    = 'F';
+        if (n >= 10) *++dst = '0' + n / 10;
+        dst[1] = '0' + n % 10;
+        return true;
+    }
+    for (uint8_t i = 0; i < ARRAY_SIZE(label_table); i++) {
+        if (pgm_read_word(&label_table[i].keycode) == keycode) {
+            memcpy_P(dst, label_table[i].label, CELL_CHARS);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *oled_legend_label(uint16_t keycode, char label[5]) {
+    memset(label, 0, 5);
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(label_table); i++) { // vlastní a QK_ keycody mimo základní rozsah
+        if (keycode > 0xFF && pgm_read_word(&label_table[i].keycode) == keycode) {
+            memcpy_P(label, label_table[i].label, CELL_CHARS);
+            return label;
+        }
+    }
+
+    if (keycode <= 0xFF) {
+        if (!basic_label(keycode, label)) {
+            label[0] = 'x';
+            put_hex(label + 1, keycode, 2);
+        }
+        return label;
+    }
+
+    if (IS_QK_MODS(keycode)) { // modifikátory jako předpona: ^ Ctrl, + Shift, ! Alt, # Gui
+        uint8_t mods = QK_MODS_GET_MODS(keycode);
+        char   *dst  = label;
+
+        if (mods & MOD_LCTL) *dst++ = '^';
+        if (mods & MOD_LSFT) *dst++ = '+';
+        if (mods & MOD_LALT) *dst++ = '!';
+        if (mods & MOD_LGUI) *dst++ = '#';
+
+        char base[CELL_CHARS + 1] = {0};
+        basic_label(QK_MODS_GET_BASIC_KEYCODE(keycode), base);
+        strncpy(dst, base, CELL_CHARS - (dst - label));
+        return label;
+    }
+
+    if (IS_QK_MOMENTARY(keycode) || IS_QK_TO(keycode) || IS_QK_TOGGLE_LAYER(keycode)) {
+        uint8_t layer = IS_QK_MOMENTARY(keycode) ? QK_MOMENTARY_GET_LAYER(keycode) : IS_QK_TO(keycode) ? QK_TO_GET_LAYER(keycode) : QK_TOGGLE_LAYER_GET_LAYER(keycode);
+
+        label[0] = IS_QK_MOMENTARY(keycode) ? 'M' : 'T';
+        label[1] = IS_QK_MOMENTARY(keycode) ? 'O' : IS_QK_TO(keycode) ? 'O' : 'G';
+        label[2] = '0' + layer % 10;
+        return label;
+    }
+
+    put_hex(label, keycode, 4); // neznámý keycode aspoň číselně
+    return label;
+}
+
+static void draw_header(uint8_t *buf, uint8_t layer) {
+    char title[] = "Layer 0";
+
+    title[6] = '0' + layer % 10;
+    oled_text_draw(buf, 0, 0, title, OLED_TEXT_COLS, true);
+}
+
+uint8_t oled_legend_draw(uint8_t *buf, uint8_t layer) {
+    if (layer != shown_layer) {
+        oled_legend_invalidate();
+    }
+
+    if (!cleared) {
+        memset(buf, 0, OLED_FB_SIZE);
+        draw_header(buf, layer);
+        memset(shown, 0xFF, sizeof(shown)); // žádný platný keycode, všechny buňky se překreslí
+        shown_layer = layer;
+        cleared     = true;
+    }
+
+    if (!stale) return 0; // keymapa se od posledního čtení nezměnila
+
+    stale = false;
+    stats.keymap_reads++;
+
+    uint8_t drawn = 0;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            int8_t index = key_index_map[row][col];
+            if (index < 0) continue;
+
+            uint16_t keycode = keymap_key_to_keycode(layer, (keypos_t){.row = row, .col = col});
+            if (keycode == shown[index]) continue;
+
+            char label[CELL_CHARS + 1];
+            oled_text_draw(buf, row + 1, col * CELL_PITCH + 1, oled_legend_label(keycode, label), CELL_CHARS, true);
+            shown[index] = keycode;
+            drawn++;
+        }
+    }
+
+    if (drawn) {
+        stats.frames++;
+        stats.cells_drawn += drawn;
+    }
+    return drawn;
+}
+
+void oled_legend_invalidate(void) {
+    cleared = false;
+    stale   = true;
+}
+
+void oled_legend_note_via_command(uint8_t command_id) {
+    switch (command_id) {
+        case id_dynamic_keymap_set_keycode:
+        case id_dynamic_keymap_set_buffer:
+        case id_dynamic_keymap_reset:
+        case id_eeprom_reset:
+            stale = true; // VIA zapíše až po návratu z via_command_kb, čte se v příštím snímku
+            stats.via_edits++;
+            break;
+
+        default:
+            break;
+    }
+}
+
+const oled_legend_stats_t *oled_legend_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+    uint32_t frames;        // volání oled_legend_draw, která něco překreslila
+    uint32_t cells_drawn;   // překreslené buňky (klávesy)
+    uint32_t keymap_reads;  // čtení všech 11 keycodů vrstvy
+    uint32_t via_edits;     // změny keymapy z VIA, které vynutily nové čtení
+} oled_legend_stats_t;
+
+// Legenda kláves vrstvy ve tvaru LAYOUT_martin_3x3 vykreslená do bufferu po stránkách.
+// Keycody se čtou přes keymap_key_to_keycode (dynamická keymapa VIA), ale jen při změně
+// vrstvy nebo po zápisu z VIA; překreslí se jen buňky, jejichž keycode se změnil.
+uint8_t oled_legend_draw(uint8_t *buf, uint8_t layer); // vrací počet překreslených buněk
+void    oled_legend_invalidate(void);                  // příště vymazat buffer a kreslit celé
+void    oled_legend_note_via_command(uint8_t command_id); // volat z via_command_kb
+
+const char *oled_legend_label(uint16_t keycode, char label[5]); // nejvýš 4 znaky
+
+const oled_legend_stats_t *oled_legend_stats(void);
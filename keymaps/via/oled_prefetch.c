@@ -0,0 +1,145 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_prefetch.h"
+#include "oled_anim.h"
+#include "oled_fb.h"
+#include "oled_images.h"
+#include "ram_watch.h"
+#include "timing.h"
+
+// KC_CYCLE_LAYERS jde vždy na další základní vrstvu a podržení na settings vrstvu, takže
+// příští snímek je předem známý. Ve volném čase smyčky se dekóduje do náhradních bufferů
+// a samotné přepnutí je pak jen výměna ukazatele se zadním bufferem oled_fb.
+
+typedef struct {
+    uint8_t *buf;
+    uint8_t  layer; // co je v bufferu
+    uint8_t  design;
+    bool     valid;
+    uint8_t  want_layer; // co tam má být
+    uint8_t  want_design;
+} prefetch_slot_t;
+
+static uint8_t         storage[OLED_PREFETCH_SLOTS][OLED_FB_SIZE];
+RAM_ACCOUNT(sizeof(storage), OLED_PREFETCH_RAM);
+static prefetch_slot_t slots[OLED_PREFETCH_SLOTS] = {
+    {.buf = storage[0], .want_layer = 0xFF},
+    {.buf = storage[1], .want_layer = 0xFF},
+};
+static bool enabled = true;
+
+static oled_prefetch_stats_t stats;
+
+static bool     mark_pending = false;
+static bool     mark_hit     = false;
+static uint32_t mark_us      = 0;
+static uint32_t mark_pages   = 0;
+
+static int8_t find(uint8_t layer, uint8_t design) {
+    if (!enabled) return -1;
+
+    for (uint8_t i = 0; i < OLED_PREFETCH_SLOTS; i++) {
+        if (slots[i].valid && slots[i].layer == layer && slots[i].design == design) return i;
+    }
+    return -1;
+}
+
+static void decode(prefetch_slot_t *slot, uint8_t layer, uint8_t design) {
+    memcpy_P(slot->buf, oled_image(layer, design), OLED_FB_SIZE);
+    slot->layer  = layer;
+    slot->design = design;
+    slot->valid  = true;
+}
+
+static void note(bool hit) {
+    if (hit) {
+        stats.hits++;
+    } else {
+        stats.misses++;
+    }
+    mark_hit = hit;
+}
+
+void oled_prefetch_hint(uint8_t slot, uint8_t layer, uint8_t design) {
+    if (slot >= OLED_PREFETCH_SLOTS) return;
+
+    slots[slot].want_layer  = layer;
+    slots[slot].want_design = design;
+}
+
+void oled_prefetch_set_enabled(bool on) {
+    enabled = on;
+    for (uint8_t i = 0; i < OLED_PREFETCH_SLOTS; i++) {
+        slots[i].valid = false;
+    }
+}
+
+const uint8_t *oled_prefetch_frame(uint8_t layer, uint8_t design) {
+    int8_t index = find(layer, design);
+
+    note(index >= 0);
+    if (index < 0) {
+        index = 0;
+        decode(&slots[0], layer, design);
+    }
+    return slots[index].buf;
+}
+
+void oled_prefetch_load_back(uint8_t layer, uint8_t design) {
+    int8_t index = find(layer, design);
+
+    note(index >= 0);
+    if (index < 0) {
+        oled_fb_load_P(oled_image(layer, design));
+        return;
+    }
+
+    slots[index].buf   = oled_fb_exchange_back(slots[index].buf); // starý zadní buffer se stane volným slotem
+    slots[index].valid = false;
+}
+
+void oled_prefetch_mark_input(void) {
+    mark_pending = true;
+    mark_us      = timing_us();
+    mark_pages   = oled_fb_stats()->pages_sent;
+}
+
+static void track_latency(void) {
+    const oled_fb_stats_t *fb = oled_fb_stats();
+
+    if (!mark_pending || fb->pages_sent == mark_pages) return;
+
+    uint32_t latency = fb->last_sent_us - mark_us;
+
+    if (mark_hit) {
+        stats.latency_hit_last_us = latency;
+        stats.latency_hit_sum_us += latency;
+        stats.latency_hit_count++;
+    } else {
+        stats.latency_miss_last_us = latency;
+        stats.latency_miss_sum_us += latency;
+        stats.latency_miss_count++;
+    }
+    mark_pending = false;
+}
+
+void oled_prefetch_task(void) {
+    track_latency();
+
+    // během animace patří cílový snímek animaci a sběrnice je obsazená
+    if (!enabled || oled_anim_active() || oled_fb_busy()) return;
+
+    for (uint8_t i = 0; i < OLED_PREFETCH_SLOTS; i++) {
+        prefetch_slot_t *slot = &slots[i];
+
+        if (slot->want_layer == 0xFF || find(slot->want_layer, slot->want_design) >= 0) continue;
+
+        decode(slot, slot->want_layer, slot->want_design);
+        stats.decodes++;
+        return; // jeden snímek na průchod smyčkou
+    }
+}
+
+const oled_prefetch_stats_t *oled_prefetch_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OLED_PREFETCH_SLOTS 2 // další základní vrstva + settings vrstva
+#define OLED_PREFETCH_RAM (OLED_PREFETCH_SLOTS * OLED_FB_SIZE)
+
+typedef struct {
+    uint32_t hits;          // přepnutí, pro která byl snímek už připravený
+    uint32_t misses;        // přepnutí, kdy se musel dekódovat hned
+    uint32_t decodes;       // dekódování na pozadí
+    uint32_t latency_hit_last_us;  // puštění klávesy -> první odeslaná stránka, se snímkem připraveným
+    uint32_t latency_hit_sum_us;
+    uint32_t latency_hit_count;
+    uint32_t latency_miss_last_us; // totéž bez připraveného snímku
+    uint32_t latency_miss_sum_us;
+    uint32_t latency_miss_count;
+} oled_prefetch_stats_t;
+
+void oled_prefetch_hint(uint8_t slot, uint8_t layer, uint8_t design); // který snímek má slot připravit
+void oled_prefetch_task(void);                                        // dekóduje na pozadí, když displej nic nedělá
+void oled_prefetch_set_enabled(bool enabled);                         // vypnutí pro srovnání latence
+
+const uint8_t *oled_prefetch_frame(uint8_t layer, uint8_t design);   // snímek v RAM (pro animaci)
+void           oled_prefetch_load_back(uint8_t layer, uint8_t design); // snímek do zadního bufferu, při zásahu jen výměna ukazatele
+
+void oled_prefetch_mark_input(void); // volat při akci, která mění vrstvu (pro měření latence)
+
+const oled_prefetch_stats_t *oled_prefetch_stats(void);
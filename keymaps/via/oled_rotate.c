@@ -0,0 +1,104 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_fb.h"
+#include "oled_rotate.h"
+
+// Otočení a zrcadlení snímku až při odesílání stránky, takže obrázky i text se kreslí
+// vždy stejně. Pro 90/270° se snímek skládá z bloků 8x8 pixelů: stránka displeje
+// je řada 16 bloků, každý vznikne transpozicí 8 sloupcových bajtů snímku na výšku.
+
+static inline uint8_t reverse8(uint8_t b) { // bit 0 <-> 7, pro zrcadlení v rámci stránky
+    b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+    b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+    b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+    return b;
+}
+
+void oled_rotate_transpose8(const uint8_t in[8], uint8_t out[8]) {
+    // dvě 32bitová slova po 4 bajtech, prohazují se bloky 1x1, 2x2 a 4x4 bitů
+    // (Hacker's Delight, transpose8), bajt 0 jde do nejvyššího bajtu slova
+    uint32_t x = (uint32_t)in[7] << 24 | (uint32_t)in[6] << 16 | (uint32_t)in[5] << 8 | in[4];
+    uint32_t y = (uint32_t)in[3] << 24 | (uint32_t)in[2] << 16 | (uint32_t)in[1] << 8 | in[0];
+    uint32_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    out[7] = x >> 24;
+    out[6] = x >> 16;
+    out[5] = x >> 8;
+    out[4] = x;
+    out[3] = y >> 24;
+    out[2] = y >> 16;
+    out[1] = y >> 8;
+    out[0] = y;
+}
+
+static void rotate_page(const uint8_t *frame, uint8_t page, uint8_t *out, bool clockwise) {
+    // řádky stránky displeje = sloupce snímku na výšku, sloupce displeje = jeho řádky
+    uint8_t col = clockwise ? page * 8 : OLED_ROTATE_PORTRAIT_WIDTH - 8 - page * 8;
+    uint8_t block[8];
+
+    for (uint8_t k = 0; k < OLED_ROTATE_PORTRAIT_PAGES; k++) {
+        const uint8_t *src = frame + k * OLED_ROTATE_PORTRAIT_WIDTH + col;
+
+        if (clockwise) {
+            memcpy(block, src, 8);
+        } else {
+            for (uint8_t i = 0; i < 8; i++) block[i] = src[7 - i];
+        }
+
+        uint8_t rows[8]; // rows[r] = řádek r bloku, bit i = sloupec i
+        oled_rotate_transpose8(block, rows);
+
+        for (uint8_t r = 0; r < 8; r++) {
+            if (clockwise) {
+                out[OLED_FB_WIDTH - 1 - (k * 8 + r)] = rows[r];
+            } else {
+                out[k * 8 + r] = rows[r];
+            }
+        }
+    }
+}
+
+void oled_rotate_page(oled_orient_t orient, const uint8_t *frame, uint8_t page, uint8_t *out) {
+    const uint8_t *src = frame + page * OLED_FB_WIDTH;
+    const uint8_t *flip = frame + (OLED_FB_PAGES - 1 - page) * OLED_FB_WIDTH;
+
+    switch (orient) {
+        case OLED_ORIENT_180:
+            for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) out[x] = reverse8(flip[OLED_FB_WIDTH - 1 - x]);
+            break;
+
+        case OLED_ORIENT_MIRROR_X:
+            for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) out[x] = src[OLED_FB_WIDTH - 1 - x];
+            break;
+
+        case OLED_ORIENT_MIRROR_Y:
+            for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) out[x] = reverse8(flip[x]);
+            break;
+
+        case OLED_ORIENT_90:
+            rotate_page(frame, page, out, true);
+            break;
+
+        case OLED_ORIENT_270:
+            rotate_page(frame, page, out, false);
+            break;
+
+        default:
+            memcpy(out, src, OLED_FB_WIDTH);
+            break;
+    }
+}
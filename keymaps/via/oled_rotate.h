@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+typedef enum {
+    OLED_ORIENT_0 = 0,
+    OLED_ORIENT_180,      // deska otočená vzhůru nohama
+    OLED_ORIENT_MIRROR_X, // zrcadlení zleva doprava
+    OLED_ORIENT_MIRROR_Y, // zrcadlení shora dolů
+    OLED_ORIENT_90,       // snímek je kreslený na výšku (32x128), na displej otočený doprava
+    OLED_ORIENT_270,      // totéž otočené doleva
+    OLED_ORIENT_COUNT,
+} oled_orient_t;
+
+// Na výšku má snímek stejných 512 bajtů, ale je to 16 stránek po 32 sloupcích.
+#define OLED_ROTATE_PORTRAIT_WIDTH (OLED_DISPLAY_HEIGHT)
+#define OLED_ROTATE_PORTRAIT_PAGES (OLED_DISPLAY_WIDTH / 8)
+
+// Transpozice bloku 8x8: bajt i výstupu = bit i všech vstupních bajtů (bit j = vstup j).
+void oled_rotate_transpose8(const uint8_t in[8], uint8_t out[8]);
+
+// Složí stránku displeje 'page' (128 bajtů) ze snímku 'frame' v dané orientaci.
+void oled_rotate_page(oled_orient_t orient, const uint8_t *frame, uint8_t page, uint8_t *out);
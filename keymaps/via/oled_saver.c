@@ -0,0 +1,189 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_saver.h"
+#include "oled_fb.h"
+#include "oled_i2c.h"
+#include "trace.h"
+
+// Spořič displeje jen příkazy řadiče SSD1306, bez překreslování: po nečinnosti
+// klesne kontrast v několika krocích, pak se obraz jednou za OLED_SAVER_ORBIT_MS
+// posune o pixel offsetem displeje (0xD3) a po OLED_SAVER_SCROLL_MS se zapne pomalý
+// hardwarový scroll. Po sběrnici jde pár bajtů za minutu, obsah RAM displeje zůstává.
+// RAM řadiče má 64 řádků a displej 128x32 ukazuje jen stránky 0-3; offset posune
+// výřez i na řádky za 4. stránkou (offset 1, 2) a pod ni (63, 62), které snímek nikdy
+// nezapisuje. Stránky 4-7 se proto před prvním posunem jednou vymažou. Po scrollu je
+// RAM podle datasheetu neplatná, takže probuzení z něj pošle celý snímek znovu
+// a stránky za obrazem se před dalším posunem mažou znovu.
+
+#define SSD1306_SET_CONTRAST 0x81
+#define SSD1306_SET_DISPLAY_OFFSET 0xD3
+#define SSD1306_SCROLL_RIGHT 0x26
+#define SSD1306_SCROLL_ACTIVATE 0x2F
+#define SSD1306_SCROLL_DEACTIVATE 0x2E
+#define SSD1306_SCROLL_256_FRAMES 0x03 // nejpomalejší krok scrollu
+#define I2C_OVERHEAD 2                 // adresa + řídicí bajt
+#define SSD1306_RAM_PAGES 8            // 64 řádků RAM i u displeje s 32 řádky
+#define PAGE_BYTES (6 + OLED_DISPLAY_WIDTH + 2 * I2C_OVERHEAD) // rozsah sloupců a stránek + data
+
+static const uint8_t orbit[] = {1, 2, 1, 0, 63, 62, 63, 0}; // offset displeje, 63 = o řádek nahoru
+
+static oled_saver_stage_t stage        = OLED_SAVER_OFF;
+static uint8_t            ramp_step    = 0;
+static uint8_t            orbit_step   = 0;
+static uint8_t            blank_page   = OLED_FB_PAGES; // další stránka RAM za obrazem k vymazání
+static uint32_t           next_ms      = 0; // čas dalšího kroku
+static uint32_t           window_ms    = 0;
+static uint32_t           window_bytes = 0;
+static uint32_t           seen_sent_us = 0; // poslední odeslání snímku, které už je započítané v shown_ms
+static uint32_t           shown_ms     = 0;
+
+static oled_saver_stats_t stats;
+
+static bool send(const uint8_t *commands, uint8_t length) {
+    if (!oled_i2c_send_commands(commands, length)) return false;
+
+    stats.commands++;
+    stats.bytes += length + I2C_OVERHEAD;
+    window_bytes += length + I2C_OVERHEAD;
+    return true;
+}
+
+static bool send_contrast(uint8_t contrast) {
+    const uint8_t commands[] = {SSD1306_SET_CONTRAST, contrast};
+
+    return send(commands, sizeof(commands));
+}
+
+static uint32_t idle_ms(void) { // od poslední klávesy i od posledního obsahu na displeji
+    if (oled_fb_stats()->last_sent_us != seen_sent_us) { // v ms, µs čas přeteče po 71 minutách
+        seen_sent_us = oled_fb_stats()->last_sent_us;
+        shown_ms     = timer_read32();
+    }
+
+    uint32_t input = last_input_activity_elapsed();
+    uint32_t shown = timer_elapsed32(shown_ms);
+
+    return input < shown ? input : shown;
+}
+
+static void wake(void) {
+    const uint8_t commands[] = {
+        SSD1306_SCROLL_DEACTIVATE,
+        SSD1306_SET_CONTRAST, oled_get_brightness(),
+        SSD1306_SET_DISPLAY_OFFSET, 0,
+    };
+
+    // bez scrollu stačí vrátit kontrast a offset, deaktivace scrollu se pošle jen po něm
+    bool scrolled = stage == OLED_SAVER_SCROLL;
+
+    if (!send(commands + (scrolled ? 0 : 1), sizeof(commands) - (scrolled ? 0 : 1))) return; // zkusí se v dalším průchodu
+
+    if (scrolled) {
+        oled_fb_resend();
+        blank_page = OLED_FB_PAGES;
+        stats.redraws++;
+    }
+
+    TRACE(OLED_SAVER, OLED_SAVER_OFF, scrolled);
+
+    stage = OLED_SAVER_OFF;
+}
+
+static void step(uint32_t idle) {
+    uint32_t now = timer_read32();
+
+    if (stage == OLED_SAVER_OFF) {
+        stage        = OLED_SAVER_DIMMING;
+        ramp_step    = 0;
+        next_ms      = now;
+        window_ms    = now;
+        window_bytes = 0;
+        stats.activations++;
+    }
+
+    if (timer_elapsed32(window_ms) >= 60000) {
+        stats.bytes_last_minute = window_bytes;
+        window_bytes            = 0;
+        window_ms               = now;
+    }
+
+    if (OLED_SAVER_SCROLL_MS && stage != OLED_SAVER_SCROLL && idle >= OLED_SAVER_SCROLL_MS) {
+        const uint8_t commands[] = {
+            SSD1306_SCROLL_RIGHT, 0x00, 0, SSD1306_SCROLL_256_FRAMES, OLED_FB_PAGES - 1, 0x00, 0xFF,
+            SSD1306_SCROLL_ACTIVATE,
+        };
+
+        if (send(commands, sizeof(commands))) {
+            stage = OLED_SAVER_SCROLL;
+            TRACE(OLED_SAVER, stage, 0);
+        }
+        return;
+    }
+
+    if ((int32_t)(now - next_ms) < 0) return;
+
+    if (stage == OLED_SAVER_DIMMING) {
+        uint8_t bright   = oled_get_brightness();
+        uint8_t target   = bright < OLED_SAVER_CONTRAST ? bright : OLED_SAVER_CONTRAST;
+        uint8_t contrast = bright - (uint16_t)(bright - target) * (ramp_step + 1) / OLED_SAVER_RAMP_STEPS;
+
+        if (!send_contrast(contrast)) return;
+
+        ramp_step++;
+
+        TRACE(OLED_SAVER, stage, contrast);
+
+        next_ms += OLED_SAVER_RAMP_MS / OLED_SAVER_RAMP_STEPS;
+
+        if (ramp_step >= OLED_SAVER_RAMP_STEPS) {
+            stage      = OLED_SAVER_ORBIT;
+            orbit_step = 0;
+            next_ms    = now + OLED_SAVER_ORBIT_MS;
+        }
+    } else if (stage == OLED_SAVER_ORBIT) {
+        if (blank_page < SSD1306_RAM_PAGES) { // stránka na průchod, offset až po vymazání všech
+            static const uint8_t blank[OLED_DISPLAY_WIDTH] = {0};
+
+            if (!oled_i2c_send_page(blank_page, blank)) return;
+
+            blank_page++;
+            stats.bytes += PAGE_BYTES;
+            window_bytes += PAGE_BYTES;
+            return;
+        }
+
+        const uint8_t commands[] = {SSD1306_SET_DISPLAY_OFFSET, orbit[orbit_step]};
+
+        if (!send(commands, sizeof(commands))) return;
+
+        TRACE(OLED_SAVER, stage, orbit[orbit_step]);
+
+        orbit_step = (orbit_step + 1) % sizeof(orbit);
+        next_ms += OLED_SAVER_ORBIT_MS;
+    }
+}
+
+void oled_saver_task(void) {
+    uint32_t idle = idle_ms();
+
+    if (idle < OLED_SAVER_DIM_MS) {
+        if (stage != OLED_SAVER_OFF) wake(); // i když displej mezitím zhasl, po rozsvícení má mít plný kontrast
+        return;
+    }
+
+    if (!is_oled_on()) return; // zhasnutý displej nemá smysl šetřit, stav zůstane do probuzení
+
+    step(idle);
+}
+
+bool oled_saver_active(void) {
+    return stage != OLED_SAVER_OFF;
+}
+
+oled_saver_stage_t oled_saver_stage(void) {
+    return stage;
+}
+
+const oled_saver_stats_t *oled_saver_stats(void) {
+    return &stats;
+}
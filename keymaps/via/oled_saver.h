@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef OLED_SAVER_DIM_MS
+#    define OLED_SAVER_DIM_MS 10000 // nečinnost, po které se začne snižovat kontrast
+#endif
+#ifndef OLED_SAVER_RAMP_MS
+#    define OLED_SAVER_RAMP_MS 2000 // doba poklesu kontrastu
+#endif
+#ifndef OLED_SAVER_RAMP_STEPS
+#    define OLED_SAVER_RAMP_STEPS 8 // kroků poklesu, každý = jeden příkaz 0x81
+#endif
+#ifndef OLED_SAVER_CONTRAST
+#    define OLED_SAVER_CONTRAST 16 // kontrast po ztlumení
+#endif
+#ifndef OLED_SAVER_ORBIT_MS
+#    define OLED_SAVER_ORBIT_MS 60000 // posun obrazu o pixel jednou za minutu
+#endif
+#ifndef OLED_SAVER_SCROLL_MS
+#    define OLED_SAVER_SCROLL_MS 300000 // nečinnost, po které se zapne hardwarový scroll, 0 = nikdy
+#endif
+
+typedef enum {
+    OLED_SAVER_OFF = 0, // plný kontrast, obraz na místě
+    OLED_SAVER_DIMMING, // klesá kontrast
+    OLED_SAVER_ORBIT,   // ztlumeno, obraz se posouvá offsetem displeje
+    OLED_SAVER_SCROLL,  // řadič sám pomalu scrolluje, RAM displeje je pak neplatná
+} oled_saver_stage_t;
+
+typedef struct {
+    uint32_t activations;       // přechody z OFF do DIMMING
+    uint32_t commands;          // transakce s příkazy
+    uint32_t bytes;             // bajty po sběrnici včetně řídicího bajtu a adresy
+    uint32_t bytes_last_minute; // za poslední celou minutu se spořičem
+    uint32_t redraws;           // celé snímky po probuzení ze scrollu
+} oled_saver_stats_t;
+
+void oled_saver_task(void);   // na začátku oled_task_user, před skládáním snímku
+bool oled_saver_active(void); // obraz je ztlumený, překreslování nic nečeká
+
+oled_saver_stage_t oled_saver_stage(void);
+
+const oled_saver_stats_t *oled_saver_stats(void);
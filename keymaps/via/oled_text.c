@@ -0,0 +1,185 @@
+#include QMK_KEYBOARD_H
+
+#include "oled_text.h"
+#include "oled_fb.h"
+#include "ram_watch.h"
+#include "timing.h"
+
+// Text nad obrázky vrstev. Atlas obsahuje předrasterizované znaky ASCII 0x20-0x7E,
+// každý jako 6 sloupcových bajtů přesně na výšku jedné stránky SSD1306, takže znak
+// je jen kopie 6 bajtů do bufferu bez jakéhokoli posouvání bitů.
+
+#define GLYPH_FIRST 0x20
+#define GLYPH_LAST 0x7E
+
+static const uint8_t PROGMEM glyph_atlas[GLYPH_LAST - GLYPH_FIRST + 1][OLED_TEXT_GLYPH_WIDTH] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // mezera
+    {0x00, 0x00, 0x5f, 0x00, 0x00, 0x00}, // !
+    {0x00, 0x07, 0x00, 0x07, 0x00, 0x00}, // "
+    {0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00}, // #
+    {0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00}, // $
+    {0x23, 0x13, 0x08, 0x64, 0x62, 0x00}, // %
+    {0x36, 0x49, 0x55, 0x22, 0x50, 0x00}, // &
+    {0x00, 0x05, 0x03, 0x00, 0x00, 0x00}, // '
+    {0x00, 0x1c, 0x22, 0x41, 0x00, 0x00}, // (
+    {0x00, 0x41, 0x22, 0x1c, 0x00, 0x00}, // )
+    {0x14, 0x08, 0x3e, 0x08, 0x14, 0x00}, // *
+    {0x08, 0x08, 0x3e, 0x08, 0x08, 0x00}, // +
+    {0x00, 0x50, 0x30, 0x00, 0x00, 0x00}, // ,
+    {0x08, 0x08, 0x08, 0x08, 0x08, 0x00}, // -
+    {0x00, 0x60, 0x60, 0x00, 0x00, 0x00}, // .
+    {0x20, 0x10, 0x08, 0x04, 0x02, 0x00}, // /
+    {0x3e, 0x51, 0x49, 0x45, 0x3e, 0x00}, // 0
+    {0x00, 0x42, 0x7f, 0x40, 0x00, 0x00}, // 1
+    {0x42, 0x61, 0x51, 0x49, 0x46, 0x00}, // 2
+    {0x21, 0x41, 0x45, 0x4b, 0x31, 0x00}, // 3
+    {0x18, 0x14, 0x12, 0x7f, 0x10, 0x00}, // 4
+    {0x27, 0x45, 0x45, 0x45, 0x39, 0x00}, // 5
+    {0x3c, 0x4a, 0x49, 0x49, 0x30, 0x00}, // 6
+    {0x01, 0x71, 0x09, 0x05, 0x03, 0x00}, // 7
+    {0x36, 0x49, 0x49, 0x49, 0x36, 0x00}, // 8
+    {0x06, 0x49, 0x49, 0x29, 0x1e, 0x00}, // 9
+    {0x00, 0x36, 0x36, 0x00, 0x00, 0x00}, // :
+    {0x00, 0x56, 0x36, 0x00, 0x00, 0x00}, // ;
+    {0x08, 0x14, 0x22, 0x41, 0x00, 0x00}, // <
+    {0x14, 0x14, 0x14, 0x14, 0x14, 0x00}, // =
+    {0x00, 0x41, 0x22, 0x14, 0x08, 0x00}, // >
+    {0x02, 0x01, 0x51, 0x09, 0x06, 0x00}, // ?
+    {0x32, 0x49, 0x79, 0x41, 0x3e, 0x00}, // @
+    {0x7e, 0x11, 0x11, 0x11, 0x7e, 0x00}, // A
+    {0x7f, 0x49, 0x49, 0x49, 0x36, 0x00}, // B
+    {0x3e, 0x41, 0x41, 0x41, 0x22, 0x00}, // C
+    {0x7f, 0x41, 0x41, 0x22, 0x1c, 0x00}, // D
+    {0x7f, 0x49, 0x49, 0x49, 0x41, 0x00}, // E
+    {0x7f, 0x09, 0x09, 0x09, 0x01, 0x00}, // F
+    {0x3e, 0x41, 0x49, 0x49, 0x7a, 0x00}, // G
+    {0x7f, 0x08, 0x08, 0x08, 0x7f, 0x00}, // H
+    {0x00, 0x41, 0x7f, 0x41, 0x00, 0x00}, // I
+    {0x20, 0x40, 0x41, 0x3f, 0x01, 0x00}, // J
+    {0x7f, 0x08, 0x14, 0x22, 0x41, 0x00}, // K
+    {0x7f, 0x40, 0x40, 0x40, 0x40, 0x00}, // L
+    {0x7f, 0x02, 0x0c, 0x02, 0x7f, 0x00}, // M
+    {0x7f, 0x04, 0x08, 0x10, 0x7f, 0x00}, // N
+    {0x3e, 0x41, 0x41, 0x41, 0x3e, 0x00}, // O
+    {0x7f, 0x09, 0x09, 0x09, 0x06, 0x00}, // P
+    {0x3e, 0x41, 0x51, 0x21, 0x5e, 0x00}, // Q
+    {0x7f, 0x09, 0x19, 0x29, 0x46, 0x00}, // R
+    {0x46, 0x49, 0x49, 0x49, 0x31, 0x00}, // S
+    {0x01, 0x01, 0x7f, 0x01, 0x01, 0x00}, // T
+    {0x3f, 0x40, 0x40, 0x40, 0x3f, 0x00}, // U
+    {0x1f, 0x20, 0x40, 0x20, 0x1f, 0x00}, // V
+    {0x3f, 0x40, 0x38, 0x40, 0x3f, 0x00}, // W
+    {0x63, 0x14, 0x08, 0x14, 0x63, 0x00}, // X
+    {0x07, 0x08, 0x70, 0x08, 0x07, 0x00}, // Y
+    {0x61, 0x51, 0x49, 0x45, 0x43, 0x00}, // Z
+    {0x00, 0x7f, 0x41, 0x41, 0x00, 0x00}, // [
+    {0x02, 0x04, 0x08, 0x10, 0x20, 0x00}, // zpětné lomítko
+    {0x00, 0x41, 0x41, 0x7f, 0x00, 0x00}, // ]
+    {0x04, 0x02, 0x01, 0x02, 0x04, 0x00}, // ^
+    {0x40, 0x40, 0x40, 0x40, 0x40, 0x00}, // _
+    {0x00, 0x01, 0x02, 0x04, 0x00, 0x00}, // `
+    {0x20, 0x54, 0x54, 0x54, 0x78, 0x00}, // a
+    {0x7f, 0x48, 0x44, 0x44, 0x38, 0x00}, // b
+    {0x38, 0x44, 0x44, 0x44, 0x20, 0x00}, // c
+    {0x38, 0x44, 0x44, 0x48, 0x7f, 0x00}, // d
+    {0x38, 0x54, 0x54, 0x54, 0x18, 0x00}, // e
+    {0x08, 0x7e, 0x09, 0x01, 0x02, 0x00}, // f
+    {0x0c, 0x52, 0x52, 0x52, 0x3e, 0x00}, // g
+    {0x7f, 0x08, 0x04, 0x04, 0x78, 0x00}, // h
+    {0x00, 0x44, 0x7d, 0x40, 0x00, 0x00}, // i
+    {0x20, 0x40, 0x44, 0x3d, 0x00, 0x00}, // j
+    {0x7f, 0x10, 0x28, 0x44, 0x00, 0x00}, // k
+    {0x00, 0x41, 0x7f, 0x40, 0x00, 0x00}, // l
+    {0x7c, 0x04, 0x18, 0x04, 0x78, 0x00}, // m
+    {0x7c, 0x08, 0x04, 0x04, 0x78, 0x00}, // n
+    {0x38, 0x44, 0x44, 0x44, 0x38, 0x00}, // o
+    {0x7c, 0x14, 0x14, 0x14, 0x08, 0x00}, // p
+    {0x08, 0x14, 0x14, 0x18, 0x7c, 0x00}, // q
+    {0x7c, 0x08, 0x04, 0x04, 0x08, 0x00}, // r
+    {0x48, 0x54, 0x54, 0x54, 0x20, 0x00}, // s
+    {0x04, 0x3f, 0x44, 0x40, 0x20, 0x00}, // t
+    {0x3c, 0x40, 0x40, 0x20, 0x7c, 0x00}, // u
+    {0x1c, 0x20, 0x40, 0x20, 0x1c, 0x00}, // v
+    {0x3c, 0x40, 0x30, 0x40, 0x3c, 0x00}, // w
+    {0x44, 0x28, 0x10, 0x28, 0x44, 0x00}, // x
+    {0x0c, 0x50, 0x50, 0x50, 0x3c, 0x00}, // y
+    {0x44, 0x64, 0x54, 0x4c, 0x44, 0x00}, // z
+    {0x00, 0x08, 0x36, 0x41, 0x00, 0x00}, // {
+    {0x00, 0x00, 0x7f, 0x00, 0x00, 0x00}, // |
+    {0x00, 0x41, 0x36, 0x08, 0x00, 0x00}, // }
+    {0x08, 0x04, 0x08, 0x10, 0x08, 0x00}, // ~
+};
+
+static oled_text_stats_t stats;
+
+static inline void draw_glyph(uint8_t *dst, char ch, bool opaque) {
+    if (ch < GLYPH_FIRST || ch > GLYPH_LAST) ch = '?';
+
+    const uint8_t *glyph = glyph_atlas[ch - GLYPH_FIRST];
+
+    if (opaque) {
+        memcpy_P(dst, glyph, OLED_TEXT_GLYPH_WIDTH);
+    } else {
+        for (uint8_t i = 0; i < OLED_TEXT_GLYPH_WIDTH; i++) {
+            dst[i] |= pgm_read_byte(glyph + i);
+        }
+    }
+    stats.glyphs_drawn++;
+}
+
+void oled_text_draw(uint8_t *buf, uint8_t row, uint8_t col, const char *text, uint8_t width, bool opaque) {
+    if (row >= OLED_TEXT_ROWS) return;
+
+    uint8_t *dst = buf + row * OLED_DISPLAY_WIDTH + col * OLED_TEXT_GLYPH_WIDTH;
+
+    for (uint8_t i = 0; i < width && col + i < OLED_TEXT_COLS; i++) {
+        char ch = *text ? *text++ : ' ';
+        draw_glyph(dst, ch, opaque);
+        dst += OLED_TEXT_GLYPH_WIDTH;
+    }
+}
+
+uint8_t oled_text_field(uint8_t *buf, oled_text_field_t *field, const char *text) {
+    uint8_t  changed = 0;
+    uint8_t *dst     = buf + field->row * OLED_DISPLAY_WIDTH + field->col * OLED_TEXT_GLYPH_WIDTH;
+
+    for (uint8_t i = 0; i < field->width && field->col + i < OLED_TEXT_COLS; i++) {
+        char ch = *text ? *text++ : ' ';
+
+        if (field->shown[i] != ch) {
+            draw_glyph(dst, ch, true);
+            field->shown[i] = ch;
+            changed++;
+        }
+        dst += OLED_TEXT_GLYPH_WIDTH;
+    }
+    return changed;
+}
+
+void oled_text_field_reset(oled_text_field_t *field) {
+    memset(field->shown, 0, sizeof(field->shown));
+}
+
+#ifdef OLED_TEXT_BENCHMARK
+// jednorázové měření na zařízení, kreslí do pomocného bufferu mimo displej
+void oled_text_benchmark(void) {
+    static uint8_t    scratch[OLED_FB_SIZE];
+    RAM_ACCOUNT(sizeof(scratch), OLED_TEXT_RAM);
+    oled_text_field_t field = {.row = 3, .col = 0, .width = OLED_TEXT_COLS};
+    uint32_t          start = timing_us();
+
+    for (uint8_t row = 0; row < OLED_TEXT_ROWS; row++) {
+        oled_text_draw(scratch, row, 0, "ABCDEFGHIJKLMNOPQRSTU", OLED_TEXT_COLS, true);
+    }
+    stats.full_redraw_us = timing_us() - start;
+
+    oled_text_field(scratch, &field, "Haptic:ON Dwell:20ms");
+    start = timing_us();
+    oled_text_field(scratch, &field, "Haptic:ON Dwell:25ms");
+    stats.field_us = timing_us() - start;
+}
+#endif
+
+const oled_text_stats_t *oled_text_stats(void) {
+    return &stats;
+}
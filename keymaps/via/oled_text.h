@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define OLED_TEXT_GLYPH_WIDTH 6 // 5 sloupců znaku + 1 mezera, výška = jedna stránka (8 px)
+#define OLED_TEXT_COLS (OLED_DISPLAY_WIDTH / OLED_TEXT_GLYPH_WIDTH) // 21 znaků na řádek
+#define OLED_TEXT_ROWS (OLED_DISPLAY_HEIGHT / 8)                   // 4 řádky
+#ifdef OLED_TEXT_BENCHMARK
+#    define OLED_TEXT_RAM (OLED_DISPLAY_WIDTH * OLED_TEXT_ROWS) // pomocný buffer oled_text_benchmark
+#else
+#    define OLED_TEXT_RAM 0
+#endif
+
+typedef struct {
+    uint8_t row;   // stránka 0-3
+    uint8_t col;   // sloupec ve znacích 0-20
+    uint8_t width; // šířka pole ve znacích, kratší text se doplní mezerami
+    char    shown[OLED_TEXT_COLS + 1]; // co je v poli vykreslené, '\0' = neplatné
+} oled_text_field_t;
+
+typedef struct {
+    uint32_t glyphs_drawn;
+    uint32_t full_redraw_us; // naměřeno oled_text_benchmark(): 21x4 znaků
+    uint32_t field_us;       // naměřeno oled_text_benchmark(): pole s jedním změněným znakem
+} oled_text_stats_t;
+
+// kreslí přímo do bufferu v pořadí stránek SSD1306 (např. oled_fb_back())
+void oled_text_draw(uint8_t *buf, uint8_t row, uint8_t col, const char *text, uint8_t width, bool opaque);
+
+// překreslí jen znaky, které se od minula změnily, vrací počet překreslených znaků
+uint8_t oled_text_field(uint8_t *buf, oled_text_field_t *field, const char *text);
+void    oled_text_field_reset(oled_text_field_t *field); // pod polem se změnil obrázek, příště překreslit celé
+
+#ifdef OLED_TEXT_BENCHMARK
+void oled_text_benchmark(void); // výsledek v oled_text stats (tools/stats_dump.py)
+#endif
+
+const oled_text_stats_t *oled_text_stats(void);
@@ -0,0 +1,293 @@
+#include QMK_KEYBOARD_H
+
+#include "dynamic_keymap.h"
+#include "solenoid.h"
+
+#include "profile_bank.h"
+#include "keymap_user.h"
+#include "flash_store.h"
+#include "macro_recorder.h"
+#include "ram_watch.h"
+#include "user_settings.h"
+#include "timing.h"
+#include "trace.h"
+#ifdef OLED_ENABLE
+#    include "oled_legend.h"
+#endif
+
+// Profily pro víc uživatelů jednoho padu. Profil 0 je živá keymapa VIA v EEPROM,
+// profily 1..N-1 jsou banky ve flash, každá v jednom sektoru: 4 vrstvy keymapy,
+// design displeje a haptika. Přepnutí nic nezapisuje: keymapa banky se zkopíruje
+// do cache v RAM (96 B), na kterou ukáže keymap_key_to_keycode, a design s haptikou
+// se nastaví jen v RAM. Číslo profilu se uloží líně s user_settings.
+// Banku plní PROFILE_STORE z aktuální keymapy VIA, editace ve VIA tak zůstává
+// jediným editorem a banky jsou její snímky. Příkaz jen pořídí snímek do RAM,
+// mazání a zápis (XIP stojí ~50 ms) udělá profile_bank_task, až se nepíše.
+
+#define PROFILE_MAGIC 0x5046 // 'PF'
+#define PROFILE_VERSION 1
+
+typedef struct {
+    uint16_t keymap[PROFILE_LAYERS][MATRIX_ROWS][MATRIX_COLS];
+    uint8_t  display_design;
+    uint8_t  haptic_enable;
+    uint8_t  haptic_dwell;
+    uint8_t  version;
+    uint16_t reserved;
+    uint16_t magic; // poslední, nedopsaná stránka nemá platný magic
+} profile_record_t;
+
+_Static_assert(sizeof(profile_record_t) <= FLASH_STORE_PAGE_SIZE, "banka profilu se nevejde do stránky");
+_Static_assert(PROFILE_COUNT >= 1 && PROFILE_COUNT - 1 <= PROFILE_FLASH_SIZE / FLASH_STORE_SECTOR_SIZE, "PROFILE_FLASH_SIZE nestačí na PROFILE_COUNT bank");
+
+typedef struct { // stav profilu 0, který přepnutí na banku přepíše v RAM
+    uint8_t display_design;
+    bool    haptic_enable;
+    uint8_t haptic_dwell;
+} live_state_t;
+
+static uint16_t cache[PROFILE_LAYERS][MATRIX_ROWS][MATRIX_COLS];
+static const uint16_t (*active_keymap)[MATRIX_ROWS][MATRIX_COLS] = NULL; // NULL = dynamická keymapa VIA
+static uint8_t      active = 0;
+static live_state_t live;
+static live_state_t session; // haptika banky, dokud haptic_config drží hodnoty profilu 0 kvůli zápisu
+
+static profile_stats_t stats;
+
+static const profile_record_t *bank(uint8_t profile) {
+    return (const profile_record_t *)flash_store_read(PROFILE_FLASH_OFFSET + (profile - 1) * FLASH_STORE_SECTOR_SIZE);
+}
+
+static bool bank_valid(uint8_t profile) {
+    if (profile == 0) return true;
+    if (profile >= PROFILE_COUNT) return false;
+
+    const profile_record_t *record = bank(profile);
+
+    return record->magic == PROFILE_MAGIC && record->version == PROFILE_VERSION;
+}
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) { // všechna čtení keycodů QMK, legenda i chordy
+    if (active_keymap && layer < PROFILE_LAYERS && key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return active_keymap[layer][key.row][key.col];
+    }
+    return keycode_at_keymap_location(layer, key.row, key.col);
+}
+
+static void apply_haptic(bool enable, uint8_t dwell) { // jen RAM, konfigurace haptiky v EEPROM patří profilu 0
+    haptic_config.enable = enable;
+    haptic_config.dwell  = dwell;
+    solenoid_set_dwell(dwell); // driver má vlastní kopii dwell, haptic_config čte jen haptic_init
+    haptic_settings_changed();
+}
+
+// haptic_config je jedna struktura pro RAM i EEPROM a QMK ji ukládá celou (HF_* klávesy, haptic_set_dwell),
+// proto při aktivní bance každý zápis uzavírá begin/end, jinak by se hodnoty banky uložily profilu 0
+void profile_bank_haptic_save_begin(void) {
+    if (active == 0) return;
+
+    session.haptic_enable = haptic_config.enable;
+    session.haptic_dwell  = haptic_config.dwell;
+    haptic_config.enable  = live.haptic_enable;
+    haptic_config.dwell   = live.haptic_dwell;
+}
+
+void profile_bank_haptic_save_end(void) {
+    if (active == 0) return;
+
+    bool    enable = haptic_config.enable != live.haptic_enable ? haptic_config.enable : session.haptic_enable;
+    uint8_t dwell  = haptic_config.dwell != live.haptic_dwell ? haptic_config.dwell : session.haptic_dwell;
+
+    live.haptic_enable = haptic_config.enable;
+    live.haptic_dwell  = haptic_config.dwell;
+    apply_haptic(enable, dwell);
+}
+
+static void load_bank(uint8_t profile) { // ukazatel na cache a hodnoty banky do RAM
+    const profile_record_t *record = bank(profile);
+
+    memcpy(cache, record->keymap, sizeof(cache));
+    active_keymap  = cache;
+    display_design_set(record->display_design < DISPLAY_DESIGNS ? record->display_design : 0);
+    apply_haptic(record->haptic_enable, record->haptic_dwell);
+}
+
+bool profile_bank_select(uint8_t profile) {
+    if (!bank_valid(profile)) return false;
+    if (profile == active) return true;
+
+    uint32_t start = timing_us();
+    uint32_t pages = flash_store_stats()->pages_programmed;
+
+    if (active == 0) {
+        live.display_design = display_design;
+        live.haptic_enable  = haptic_config.enable;
+        live.haptic_dwell   = haptic_config.dwell;
+    }
+
+    if (profile == 0) {
+        active_keymap  = NULL;
+        display_design_set(live.display_design);
+        apply_haptic(live.haptic_enable, live.haptic_dwell);
+    } else {
+        load_bank(profile);
+    }
+
+    active = profile;
+
+    if (user_settings.profile != profile) { // při startu už je uložený
+        user_settings.profile = profile;
+        user_settings_changed(); // jeden bajt v EEPROM, až se přestane přepínat
+    }
+
+#ifdef OLED_ENABLE
+    oled_legend_invalidate(); // legenda se přečte z nové keymapy
+#endif
+
+    stats.switches++;
+    stats.last_switch_us    = timing_us() - start;
+    stats.last_switch_bytes = (flash_store_stats()->pages_programmed - pages) * FLASH_STORE_PAGE_SIZE;
+    if (stats.last_switch_us > stats.max_switch_us) stats.max_switch_us = stats.last_switch_us;
+
+    TRACE(PROFILE_SWITCH, profile, stats.last_switch_us);
+
+    return true;
+}
+
+void profile_bank_next(void) {
+    for (uint8_t i = 1; i <= PROFILE_COUNT; i++) {
+        uint8_t profile = (active + i) % PROFILE_COUNT;
+
+        if (profile_bank_select(profile)) return; // prázdné banky se přeskočí, profil 0 platí vždy
+    }
+}
+
+static union { // snímek čekající na zápis do banky
+    profile_record_t record;
+    uint8_t          page[FLASH_STORE_PAGE_SIZE];
+} pending;
+static uint8_t pending_profile = 0; // 0 = nic nečeká
+static bool    pending_erased  = false;
+RAM_ACCOUNT(sizeof(cache) + sizeof(active_keymap) + sizeof(active) + sizeof(live) + sizeof(session) + sizeof(stats) + sizeof(pending) + sizeof(pending_profile) + sizeof(pending_erased), PROFILE_RAM);
+
+static bool store(uint8_t profile) { // snímek živé keymapy VIA do RAM, do flash ho zapíše profile_bank_task
+    if (profile == 0 || profile >= PROFILE_COUNT) return false;
+    if (pending_profile != 0) return false; // předchozí snímek ještě není zapsaný
+
+    memset(pending.page, 0xFF, sizeof(pending.page));
+
+    for (uint8_t layer = 0; layer < PROFILE_LAYERS; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                pending.record.keymap[layer][row][col] = dynamic_keymap_get_keycode(layer, row, col);
+            }
+        }
+    }
+
+    bool from_live = active == 0; // na bance platí design a haptika banky, živé hodnoty jsou odložené
+
+    pending.record.display_design = from_live ? display_design : live.display_design;
+    pending.record.haptic_enable  = from_live ? haptic_config.enable : live.haptic_enable;
+    pending.record.haptic_dwell   = from_live ? haptic_config.dwell : live.haptic_dwell;
+    pending.record.version        = PROFILE_VERSION;
+    pending.record.magic          = PROFILE_MAGIC;
+
+    pending_profile = profile;
+    pending_erased  = false;
+    return true;
+}
+
+void profile_bank_task(void) {
+    if (pending_profile == 0) return;
+    if (last_input_activity_elapsed() < PROFILE_STORE_IDLE_MS) return;
+    if (macro_recorder_state() != MACRO_IDLE) return; // makro má s flash přednost
+
+    uint32_t offset = PROFILE_FLASH_OFFSET + (pending_profile - 1) * FLASH_STORE_SECTOR_SIZE;
+    uint32_t start  = timing_us();
+
+    if (!pending_erased) { // mazání je delší blokující krok, zápis až v dalším průchodu
+        flash_store_erase_sector(offset);
+        pending_erased      = true;
+        stats.last_store_us = timing_us() - start;
+        return;
+    }
+
+    flash_store_program_page(offset, pending.page);
+
+    stats.stores++;
+    stats.last_store_us += timing_us() - start;
+    stats.last_store_bytes = FLASH_STORE_PAGE_SIZE;
+
+    if (pending_profile == active) { // přepsaná aktivní banka: obnovit cache
+        load_bank(pending_profile);
+#ifdef OLED_ENABLE
+        oled_legend_invalidate();
+#endif
+    }
+    pending_profile = 0;
+}
+
+void profile_bank_init(void) {
+    active = 0;
+
+    if (!profile_bank_select(user_settings.profile)) {
+        user_settings.profile = 0; // banka mezitím zmizela
+    }
+}
+
+uint8_t profile_bank_active(void) {
+    return active;
+}
+
+void profile_bank_command(uint8_t *data) {
+    uint8_t  op      = data[1];
+    uint8_t  profile = data[2];
+    uint8_t *out     = &data[4];
+    bool     ok      = true;
+
+    switch (op) {
+        case PROFILE_SELECT:
+            ok = profile_bank_select(profile);
+            memcpy(out, &stats.last_switch_us, sizeof(uint32_t));
+            memcpy(out + 4, &stats.last_switch_bytes, sizeof(uint32_t));
+            break;
+
+        case PROFILE_STORE: {
+            uint32_t start = timing_us();
+
+            ok = store(profile);
+
+            uint32_t spent = timing_us() - start;
+
+            memcpy(out, &spent, sizeof(spent));
+            out[4] = pending_profile;
+            break;
+        }
+
+        case PROFILE_INFO: {
+            uint8_t valid = 0;
+
+            for (uint8_t i = 0; i < PROFILE_COUNT && i < 8; i++) {
+                if (bank_valid(i)) valid |= 1 << i;
+            }
+            out[0] = PROFILE_COUNT;
+            out[1] = valid;
+            memcpy(out + 2, &stats.last_switch_us, sizeof(uint32_t));
+            out[6] = pending_profile;
+            memcpy(out + 7, &stats.last_store_us, sizeof(uint32_t));
+            memcpy(out + 11, &stats.last_store_bytes, sizeof(uint32_t));
+            break;
+        }
+
+        default:
+            ok = false;
+            break;
+    }
+
+    data[2] = ok ? RAW_HID_OK : RAW_HID_INVALID;
+    data[3] = active;
+}
+
+const profile_stats_t *profile_bank_stats(void) {
+    return &stats;
+}
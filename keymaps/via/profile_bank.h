@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef PROFILE_COUNT
+#    define PROFILE_COUNT 4 // profil 0 = živá keymapa VIA, ostatní jsou banky ve flash
+#endif
+
+#ifndef PROFILE_STORE_IDLE_MS
+#    define PROFILE_STORE_IDLE_MS 500 // snímek banky se zapíše až po této době bez stisku (mazání blokuje XIP)
+#endif
+
+#define PROFILE_LAYERS 4 // DYNAMIC_KEYMAP_LAYER_COUNT
+// cache keymapy aktivní banky, stránka čekající na zápis, ukazatel na keymapu, aktivní profil,
+// stav profilu 0 a haptika banky během zápisu (2x 3 B), cíl a fáze zápisu, čítače
+#define PROFILE_RAM (PROFILE_LAYERS * MATRIX_ROWS * MATRIX_COLS * 2 + FLASH_STORE_PAGE_SIZE + sizeof(void *) + 1 + 2 * 3 + 2 + sizeof(profile_stats_t))
+
+// podpříkazy RAW_HID_PROFILE: [0x43, op, profil] -> [0x43, op, stav, aktivní profil, data...]
+enum profile_ops {
+    PROFILE_SELECT = 0, // přepne profil; data: µs přepnutí (4 B), bajty zapsané do flash (4 B)
+    PROFILE_STORE  = 1, // snímek živé keymapy VIA, designu a haptiky pro banku 1..N-1, do flash se zapíše později; data: µs snímku (4 B), čekající banka
+    PROFILE_INFO   = 2, // data: počet profilů, bitmapa platných bank, µs posledního přepnutí (4 B), čekající banka (0 = nic),
+                        //       µs posledního zápisu banky (4 B), zapsané bajty (4 B)
+};
+
+typedef struct {
+    uint32_t switches;
+    uint32_t last_switch_us;    // výměna ukazatele + obnova cache v RAM
+    uint32_t max_switch_us;
+    uint32_t last_switch_bytes; // zapsáno do flash při přepnutí (profil v EEPROM se zapíše později líně)
+    uint32_t stores;
+    uint32_t last_store_us;     // mazání + zápis stránky, v profile_bank_task
+    uint32_t last_store_bytes;
+} profile_stats_t;
+
+void    profile_bank_init(void);          // po user_settings_init, vybere uložený profil; haptic_config už načetlo jádro
+// kolem každého zápisu haptic_config do EEPROM: begin vrátí hodnoty profilu 0, end vrátí hodnoty
+// banky a změněné pole převezme (úprava na bance platí hned a uloží se profilu 0)
+void    profile_bank_haptic_save_begin(void);
+void    profile_bank_haptic_save_end(void);
+bool    profile_bank_select(uint8_t profile); // false = banka je prázdná nebo mimo rozsah
+void    profile_bank_next(void);          // další platný profil (KC_PROFILE_NEXT)
+uint8_t profile_bank_active(void);
+void    profile_bank_task(void);          // odložený zápis snímku z PROFILE_STORE do flash
+void    profile_bank_command(uint8_t *data); // raw HID, odpověď se zapíše do data
+
+const profile_stats_t *profile_bank_stats(void);
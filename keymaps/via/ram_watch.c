@@ -0,0 +1,152 @@
+#include QMK_KEYBOARD_H
+
+#include "hal.h"
+
+#include "ram_watch.h"
+#include "keymap_user.h"
+#include "user_settings.h"
+#include "profile_bank.h"
+#include "chord_engine.h"
+#include "macro_recorder.h"
+#include "key_heatmap.h"
+#include "event_bus.h"
+#include "flash_store.h"
+#include "trace.h"
+#include "oled_fb.h"
+#include "oled_anim.h"
+#include "oled_prefetch.h"
+#include "oled_gray.h"
+#include "oled_text.h"
+#include "oled_i2c.h"
+
+// Zásobníky jádra 0 natře vzorem už crt0 ChibiOS (CRT0_INIT_STACKS) před main,
+// zásobníky nespuštěného jádra 1 (RP_CORE1_START) natře ram_watch_init; hlásí nulu,
+// dokud na něm něco nepoběží. High-water mark je první přepsané slovo odspodu.
+// Statická RAM se počítá po podsystémech z velikostí, které moduly hlásí
+// v hlavičkách (*_RAM); RAM_ACCOUNT v každém modulu hlídá, že hlášená velikost sedí
+// se součtem jeho statických proměnných, a tady _Static_assert hlídá rozpočty z config.h.
+
+extern uint32_t __main_stack_base__[], __main_stack_end__[];
+extern uint32_t __process_stack_base__[], __process_stack_end__[];
+extern uint32_t __c1_main_stack_base__[], __c1_main_stack_end__[];
+extern uint32_t __c1_process_stack_base__[], __c1_process_stack_end__[];
+extern uint8_t  __data_base__[], __data_end__[], __bss_base__[], __bss_end__[];
+extern uint8_t  __heap_base__[], __heap_end__[];
+
+#define RAM_USED_OLED (OLED_FB_RAM + OLED_ANIM_RAM + OLED_PREFETCH_RAM + OLED_GRAY_RAM + OLED_TEXT_RAM + OLED_I2C_RAM)
+#define RAM_USED_HAPTIC HAPTIC_RAM
+#define RAM_USED_KEYMAP (PROFILE_RAM + CHORD_RAM)
+#define RAM_USED_VIA USER_SETTINGS_RAM
+#define RAM_USED_BUFFERS (MACRO_RING_RAM + TRACE_RAM + HEATMAP_RAM + EVENT_BUS_RAM + FLASH_STORE_RAM)
+
+_Static_assert(RAM_USED_OLED <= RAM_BUDGET_OLED, "OLED překročil RAM_BUDGET_OLED");
+_Static_assert(RAM_USED_HAPTIC <= RAM_BUDGET_HAPTIC, "haptika překročila RAM_BUDGET_HAPTIC");
+_Static_assert(RAM_USED_KEYMAP <= RAM_BUDGET_KEYMAP, "cache keymapy překročila RAM_BUDGET_KEYMAP");
+_Static_assert(RAM_USED_VIA <= RAM_BUDGET_VIA, "nastavení VIA překročilo RAM_BUDGET_VIA");
+_Static_assert(RAM_USED_BUFFERS <= RAM_BUDGET_BUFFERS, "fronty a buffery překročily RAM_BUDGET_BUFFERS");
+
+static const uint16_t used[RAM_SUBSYSTEMS]   = {RAM_USED_OLED, RAM_USED_HAPTIC, RAM_USED_KEYMAP, RAM_USED_VIA, RAM_USED_BUFFERS};
+static const uint16_t budget[RAM_SUBSYSTEMS] = {RAM_BUDGET_OLED, RAM_BUDGET_HAPTIC, RAM_BUDGET_KEYMAP, RAM_BUDGET_VIA, RAM_BUDGET_BUFFERS};
+
+typedef struct {
+    uint32_t *base; // nejnižší adresa, zásobník roste dolů k ní
+    uint32_t *end;
+} stack_region_t;
+
+static const stack_region_t regions[STACKS] = {
+    [STACK_CORE0_MAIN]    = {__main_stack_base__, __main_stack_end__},
+    [STACK_CORE0_PROCESS] = {__process_stack_base__, __process_stack_end__},
+    [STACK_CORE1_MAIN]    = {__c1_main_stack_base__, __c1_main_stack_end__},
+    [STACK_CORE1_PROCESS] = {__c1_process_stack_base__, __c1_process_stack_end__},
+};
+
+static stack_usage_t stacks[STACKS];
+static uint32_t      last_scan = 0;
+
+#if RP_CORE1_START == FALSE
+static void paint(const stack_region_t *region) {
+    for (uint32_t *word = region->base; word < region->end; word++) {
+        *word = STACK_PAINT_PATTERN;
+    }
+}
+#endif
+
+static uint16_t high_water(const stack_region_t *region) {
+    const uint32_t *word = region->base;
+
+    while (word < region->end && *word == STACK_PAINT_PATTERN) word++;
+
+    return (region->end - word) * sizeof(uint32_t);
+}
+
+static void scan(void) {
+    for (uint8_t i = 0; i < STACKS; i++) {
+        uint16_t hwm = high_water(&regions[i]);
+
+        if (hwm > stacks[i].used) {
+            stacks[i].used = hwm;
+            TRACE(STACK_HIGH_WATER, i, hwm);
+        }
+    }
+    last_scan = timer_read32();
+}
+
+void ram_watch_init(void) {
+#if RP_CORE1_START == FALSE // crt0 natírá jen zásobníky jádra 0
+    paint(&regions[STACK_CORE1_MAIN]);
+    paint(&regions[STACK_CORE1_PROCESS]);
+#endif
+
+    for (uint8_t i = 0; i < STACKS; i++) {
+        stacks[i].size = (regions[i].end - regions[i].base) * sizeof(uint32_t);
+    }
+}
+
+void ram_watch_task(void) {
+    if (timer_elapsed32(last_scan) >= RAM_WATCH_MS) scan();
+}
+
+void ram_watch_command(uint8_t *data) {
+    uint8_t  op  = data[1];
+    uint8_t *out = &data[4];
+    bool     ok  = true;
+
+    switch (op) {
+        case RAM_WATCH_STACKS:
+            scan(); // čerstvý stav, ne ten z posledního RAM_WATCH_MS
+            data[3] = STACKS;
+            for (uint8_t i = 0; i < STACKS; i++, out += 4) {
+                memcpy(out, &stacks[i].size, sizeof(uint16_t));
+                memcpy(out + 2, &stacks[i].used, sizeof(uint16_t));
+            }
+            break;
+
+        case RAM_WATCH_BUDGET: {
+            uint32_t static_ram = (__data_end__ - __data_base__) + (__bss_end__ - __bss_base__);
+            uint32_t free_ram   = __heap_end__ - __heap_base__; // zbytek RAM za .bss, QMK ho nealokuje
+
+            data[3] = RAM_SUBSYSTEMS;
+            for (uint8_t i = 0; i < RAM_SUBSYSTEMS; i++, out += 4) {
+                memcpy(out, &used[i], sizeof(uint16_t));
+                memcpy(out + 2, &budget[i], sizeof(uint16_t));
+            }
+            memcpy(out, &static_ram, sizeof(static_ram));
+            memcpy(out + 4, &free_ram, sizeof(free_ram));
+            break;
+        }
+
+        default:
+            ok = false;
+            break;
+    }
+
+    data[2] = ok ? RAW_HID_OK : RAW_HID_INVALID;
+}
+
+const stack_usage_t *ram_watch_stack(stack_id_t stack) {
+    return &stacks[stack];
+}
+
+uint16_t ram_watch_used(ram_subsystem_t subsystem) {
+    return used[subsystem];
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Rozpočty statické RAM podsystémů v bajtech. Překročení zastaví překlad
+// (_Static_assert v ram_watch.c), zaplněnost se dá vyčíst přes raw HID.
+#ifndef RAM_BUDGET_OLED
+#    define RAM_BUDGET_OLED 4608
+#endif
+#ifndef RAM_BUDGET_HAPTIC
+#    define RAM_BUDGET_HAPTIC 16
+#endif
+#ifndef RAM_BUDGET_KEYMAP
+#    define RAM_BUDGET_KEYMAP 1280
+#endif
+#ifndef RAM_BUDGET_VIA
+#    define RAM_BUDGET_VIA 64
+#endif
+#ifndef RAM_BUDGET_BUFFERS
+#    define RAM_BUDGET_BUFFERS 4096
+#endif
+
+#ifndef RAM_WATCH_MS
+#    define RAM_WATCH_MS 1000 // jak často se hledá nejhlubší místo zásobníků
+#endif
+
+#define STACK_PAINT_PATTERN 0x55555555 // stejný vzor jako CRT0_STACKS_FILL_PATTERN v ChibiOS
+
+// Velikost, kterou modul hlásí v hlavičce (*_RAM), musí sedět se skutečnou alokací.
+// Použití v .c modulu hned za alokací: RAM_ACCOUNT(sizeof(buffers), OLED_FB_RAM);
+#define RAM_ACCOUNT(size, expected) _Static_assert((size) == (expected), #expected " neodpovídá alokaci v modulu")
+
+typedef enum {
+    RAM_OLED,    // framebuffery, animace, přednačtené snímky, roviny šedi, I2C
+    RAM_HAPTIC,  // konfigurace haptiky a její stav v keymap.c
+    RAM_KEYMAP,  // cache keymapy profilu, odložený zápis banky, tabulky chordů
+    RAM_VIA,     // nastavení z VIA a stav jejich líného zápisu
+    RAM_BUFFERS, // fronty a kruhové buffery (makra, trasování, heatmapa, události), stránka pro zápis do flash
+    RAM_SUBSYSTEMS,
+} ram_subsystem_t;
+
+typedef enum {
+    STACK_CORE0_MAIN,    // MSP jádra 0: přerušení
+    STACK_CORE0_PROCESS, // PSP jádra 0: hlavní vlákno (smyčka QMK)
+    STACK_CORE1_MAIN,    // jádro 1, RP_CORE1_START
+    STACK_CORE1_PROCESS,
+    STACKS,
+} stack_id_t;
+
+// podpříkazy RAW_HID_MEMORY: [0x44, op] -> [0x44, op, stav, počet, data...]
+enum ram_watch_ops {
+    RAM_WATCH_STACKS = 0, // STACKS x (velikost, nejvíc použito) po 2 B
+    RAM_WATCH_BUDGET = 1, // RAM_SUBSYSTEMS x (použito, rozpočet) po 2 B, statická RAM celkem (4 B), volná RAM za ní (4 B)
+};
+
+typedef struct {
+    uint16_t size;
+    uint16_t used; // nejhlubší místo od startu (high-water mark)
+} stack_usage_t;
+
+void ram_watch_init(void); // z keyboard_pre_init_user: natře zásobníky jádra 1, velikosti zásobníků
+void ram_watch_task(void); // občas přepočítá high-water marky
+void ram_watch_command(uint8_t *data); // raw HID, odpověď se zapíše do data
+
+const stack_usage_t *ram_watch_stack(stack_id_t stack);
+uint16_t             ram_watch_used(ram_subsystem_t subsystem);
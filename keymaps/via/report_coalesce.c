@@ -0,0 +1,251 @@
+#include QMK_KEYBOARD_H
+
+#include "host.h"
+#include "host_driver.h"
+#include "report_coalesce.h"
+#include "timing.h"
+
+// Slučování reportů: všechny změny kláves z jednoho scanu odejdou jako jeden report.
+// Původní USB ovladač obalíme vlastním, který si report jen zapamatuje, a odešleme
+// ho až na konci průchodu hlavní smyčkou. Pokud by sloučení ztratilo stisk nebo
+// puštění klávesy (např. tap_code v makru), čekající report se odešle hned.
+
+static host_driver_t *usb_driver = NULL; // původní ovladač (ChibiOS USB)
+static host_driver_t  coalesce_driver;
+
+static report_keyboard_t pending_keyboard;
+static report_keyboard_t sent_keyboard;
+static bool              keyboard_pending = false;
+
+#ifdef NKRO_ENABLE
+static report_nkro_t pending_nkro;
+static report_nkro_t sent_nkro;
+static bool          nkro_pending = false;
+#endif
+
+// Během probouzení hostitele (report_coalesce_hold) se reporty neposílají, ale řadí
+// do fronty, aby se stisk, který pad probudil, neztratil v ještě neaktivním USB.
+typedef struct {
+    bool nkro;
+    union {
+        report_keyboard_t keyboard;
+#ifdef NKRO_ENABLE
+        report_nkro_t nkro_report;
+#endif
+    };
+} queued_report_t;
+
+static bool            held = false;
+static queued_report_t queue[REPORT_QUEUE_SIZE];
+static uint8_t         queued = 0;
+
+static bool     event_open = false; // existuje událost, která ještě nebyla odeslána
+static uint32_t event_us   = 0;
+
+static report_stats_t stats = {.latency_min_us = UINT32_MAX};
+static uint32_t       window_start  = 0;
+static uint16_t       window_report = 0;
+
+static void note_report_sent(void) {
+    uint32_t now = timing_us();
+
+    if (stats.reports_sent == 0) {
+        stats.first_report_us = now;
+    }
+    stats.reports_sent++;
+    stats.last_report_us = now;
+    window_report++;
+
+    if (event_open) {
+        uint32_t latency = now - event_us;
+
+        if (latency < stats.latency_min_us) stats.latency_min_us = latency;
+        if (latency > stats.latency_max_us) stats.latency_max_us = latency;
+        stats.latency_sum_us += latency;
+        stats.latency_count++;
+        event_open = false;
+    }
+}
+
+// převede 6KRO report na bitovou mapu, aby šel porovnat stejně jako NKRO
+static void keyboard_bits(const report_keyboard_t *report, uint8_t bits[32]) {
+    memset(bits, 0, 32);
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t kc = report->keys[i];
+        if (kc) bits[kc >> 3] |= 1 << (kc & 7);
+    }
+}
+
+// true, pokud by nahrazení čekajícího reportu novým vrátilo nějakou změnu zpět
+static bool keyboard_would_lose(const report_keyboard_t *next) {
+    if ((sent_keyboard.mods ^ pending_keyboard.mods) & (pending_keyboard.mods ^ next->mods)) {
+        return true;
+    }
+
+    uint8_t sent[32], pending[32], incoming[32];
+    keyboard_bits(&sent_keyboard, sent);
+    keyboard_bits(&pending_keyboard, pending);
+    keyboard_bits(next, incoming);
+
+    for (uint8_t i = 0; i < 32; i++) {
+        if ((sent[i] ^ pending[i]) & (pending[i] ^ incoming[i])) return true;
+    }
+    return false;
+}
+
+// Do fronty jde report jen tehdy, když by ho sloučení s následujícím ztratilo, takže
+// žádný záznam ve frontě nejde vypustit beze ztráty. Plná fronta proto vypustí ten
+// nejstarší a započítá to; na USB se během probouzení nic neposílá.
+static void enqueue(const queued_report_t *entry) {
+    if (queued == REPORT_QUEUE_SIZE) {
+        memmove(&queue[0], &queue[1], (REPORT_QUEUE_SIZE - 1) * sizeof(queue[0]));
+        queued--;
+        stats.reports_dropped++;
+    }
+
+    queue[queued++] = *entry;
+    stats.reports_queued++;
+}
+
+static void flush_keyboard(void) {
+    if (!keyboard_pending) return;
+
+    keyboard_pending = false;
+    sent_keyboard    = pending_keyboard;
+
+    if (held) {
+        enqueue(&(queued_report_t){.nkro = false, .keyboard = sent_keyboard});
+        return;
+    }
+
+    usb_driver->send_keyboard(&sent_keyboard);
+    note_report_sent();
+}
+
+static void coalesce_send_keyboard(report_keyboard_t *report) {
+    if (keyboard_pending) {
+        if (keyboard_would_lose(report)) {
+            flush_keyboard();
+        } else {
+            stats.reports_merged++;
+        }
+    }
+    pending_keyboard = *report;
+    keyboard_pending = true;
+}
+
+#ifdef NKRO_ENABLE
+static bool nkro_would_lose(const report_nkro_t *next) {
+    if ((sent_nkro.mods ^ pending_nkro.mods) & (pending_nkro.mods ^ next->mods)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+        if ((sent_nkro.bits[i] ^ pending_nkro.bits[i]) & (pending_nkro.bits[i] ^ next->bits[i])) return true;
+    }
+    return false;
+}
+
+static void flush_nkro(void) {
+    if (!nkro_pending) return;
+
+    nkro_pending = false;
+    sent_nkro    = pending_nkro;
+
+    if (held) {
+        enqueue(&(queued_report_t){.nkro = true, .nkro_report = sent_nkro});
+        return;
+    }
+
+    usb_driver->send_nkro(&sent_nkro);
+    note_report_sent();
+}
+
+static void coalesce_send_nkro(report_nkro_t *report) {
+    if (nkro_pending) {
+        if (nkro_would_lose(report)) {
+            flush_nkro();
+        } else {
+            stats.reports_merged++;
+        }
+    }
+    pending_nkro = *report;
+    nkro_pending = true;
+}
+#endif
+
+// myš a multimediální klávesy se neslučují, ale nesmí předběhnout čekající report
+static void coalesce_send_mouse(report_mouse_t *report) {
+    report_coalesce_flush();
+    usb_driver->send_mouse(report);
+}
+
+static void coalesce_send_extra(report_extra_t *report) {
+    report_coalesce_flush();
+    usb_driver->send_extra(report);
+}
+
+void report_coalesce_hold(bool hold) {
+    held = hold;
+
+    if (hold || usb_driver == NULL) return;
+
+    for (uint8_t i = 0; i < queued; i++) { // ve stejném pořadí, v jakém vznikly
+#ifdef NKRO_ENABLE
+        if (queue[i].nkro) {
+            usb_driver->send_nkro(&queue[i].nkro_report);
+            note_report_sent();
+            continue;
+        }
+#endif
+        usb_driver->send_keyboard(&queue[i].keyboard);
+        note_report_sent();
+    }
+    queued = 0;
+}
+
+void report_coalesce_flush(void) {
+    if (usb_driver == NULL) return;
+    if (held) return; // poslední stav čeká v pending, fronta jen to, co by sloučení ztratilo
+
+    flush_keyboard();
+#ifdef NKRO_ENABLE
+    flush_nkro();
+#endif
+}
+
+void report_coalesce_note_event(void) {
+    if (!event_open) {
+        event_open = true;
+        event_us   = timing_us();
+    }
+}
+
+void report_coalesce_task(void) {
+    host_driver_t *current = host_get_driver();
+
+    // ovladač nastavuje QMK až po keyboard_post_init_user, proto se instalujeme líně
+    if (current != NULL && current != &coalesce_driver) {
+        usb_driver                    = current;
+        coalesce_driver               = *current;
+        coalesce_driver.send_keyboard = coalesce_send_keyboard;
+#ifdef NKRO_ENABLE
+        coalesce_driver.send_nkro = coalesce_send_nkro;
+#endif
+        coalesce_driver.send_mouse = coalesce_send_mouse;
+        coalesce_driver.send_extra = coalesce_send_extra;
+        host_set_driver(&coalesce_driver);
+    }
+
+    report_coalesce_flush();
+    event_open = false; // události, které nevyvolaly žádný report, se do latence nepočítají
+
+    if (timer_elapsed32(window_start) >= REPORT_STATS_WINDOW_MS) {
+        stats.reports_per_second = (uint32_t)window_report * 1000 / REPORT_STATS_WINDOW_MS;
+        window_report            = 0;
+        window_start             = timer_read32();
+    }
+}
+
+const report_stats_t *report_coalesce_stats(void) {
+    return &stats;
+}
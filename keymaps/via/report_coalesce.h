@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef REPORT_STATS_WINDOW_MS
+#    define REPORT_STATS_WINDOW_MS 1000 // okno pro výpočet reportů za sekundu
+#endif
+
+#ifndef REPORT_QUEUE_SIZE
+#    define REPORT_QUEUE_SIZE 4 // reporty zadržené během probouzení hostitele
+#endif
+
+typedef struct {
+    uint32_t reports_sent;       // odeslané klávesnicové reporty (6KRO i NKRO)
+    uint32_t reports_merged;     // reporty sloučené do jednoho v rámci jednoho scanu
+    uint16_t reports_per_second; // počet reportů v posledním okně REPORT_STATS_WINDOW_MS
+    uint32_t latency_min_us;     // nejkratší doba od události klávesy k odeslání reportu
+    uint32_t latency_max_us;     // nejdelší doba od události klávesy k odeslání reportu
+    uint32_t latency_sum_us;     // součet pro průměr (latency_sum_us / latency_count)
+    uint32_t latency_count;
+    uint32_t first_report_us;    // čas prvního reportu od resetu
+    uint32_t last_report_us;     // čas posledního reportu od resetu
+    uint32_t reports_queued;     // zadržené během report_coalesce_hold
+    uint32_t reports_dropped;    // vypuštěné z plné fronty se ztrátou stisku nebo puštění
+} report_stats_t;
+
+void report_coalesce_note_event(void); // volat z process_record_user při každé události klávesy
+void report_coalesce_task(void);       // volat jednou za průchod hlavní smyčkou (po matrix scanu)
+void report_coalesce_flush(void);      // okamžitě odešle čekající report
+void report_coalesce_hold(bool hold);  // true = reporty jen řadit (USB ještě není po probuzení aktivní), false = odeslat frontu
+
+const report_stats_t *report_coalesce_stats(void);
@@ -10,6 +10,45 @@ BOOTMAGIC_ENABLE = yes
 HAPTIC_ENABLE = yes 
 HAPTIC_DRIVER = solenoid 
 
+NKRO_ENABLE = yes
+DEFERRED_EXEC_ENABLE = yes
+
+MATRIX_SAMPLER = no # yes = matice vzorkovaná z přerušení časovače (matrix_sampler.c)
+ifeq ($(strip $(MATRIX_SAMPLER)), yes)
+    CUSTOM_MATRIX = lite
+    OPT_DEFS += -DMATRIX_SAMPLER
+    SRC += matrix_sampler.c
+else
+    DEBOUNCE_TYPE = custom # sym_defer_g s dobou z VIA (debounce_runtime.c)
+    SRC += debounce_runtime.c
+endif
+
+SRC += event_bus.c
+SRC += report_coalesce.c
+SRC += chord_engine.c
+SRC += flash_store.c
+SRC += macro_recorder.c
+SRC += turbo_repeat.c
+SRC += key_heatmap.c
+SRC += idle_sleep.c
+SRC += boot_stage.c
+SRC += usb_suspend.c
+SRC += user_settings.c
+SRC += profile_bank.c
+SRC += trace.c
+SRC += ram_watch.c
+SRC += stats_report.c
+SRC += oled_images.c
+SRC += oled_fb.c
+SRC += oled_i2c.c
+SRC += oled_rotate.c
+SRC += oled_anim.c
+SRC += oled_prefetch.c
+SRC += oled_text.c
+SRC += oled_legend.c
+SRC += oled_gray.c
+SRC += oled_saver.c
+
 QMK_C_DEFS += -DKEYBOARD_USER_ENABLE
 
 LTO_ENABLE = yes 
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include QMK_KEYBOARD_H
+
+#include "keymap_user.h"
+#include "stats_report.h"
+#include "report_coalesce.h"
+#include "idle_sleep.h"
+#include "boot_stage.h"
+#include "turbo_repeat.h"
+#include "event_bus.h"
+#include "key_heatmap.h"
+#include "profile_bank.h"
+#include "flash_store.h"
+#include "usb_suspend.h"
+#ifdef MATRIX_SAMPLER
+#    include "matrix_sampler.h"
+#endif
+#ifdef OLED_ENABLE
+#    include "oled_fb.h"
+#    include "oled_i2c.h"
+#    include "oled_anim.h"
+#    include "oled_prefetch.h"
+#    include "oled_text.h"
+#    include "oled_legend.h"
+#    include "oled_gray.h"
+#    include "oled_saver.h"
+#endif
+
+// sizeof(*getter()) volání nevyhodnotí, jen vezme typ struktury
+#define SOURCE(id, getter)             \
+    case id:                           \
+        *size = sizeof(*getter());     \
+        return (const uint8_t *)getter()
+
+static const uint8_t *source(uint8_t id, uint8_t *size) {
+    switch (id) {
+        SOURCE(STATS_REPORT_COALESCE, report_coalesce_stats);
+        SOURCE(STATS_IDLE_SLEEP, idle_sleep_stats);
+        SOURCE(STATS_BOOT_STAGE, boot_stage_stats);
+        SOURCE(STATS_EVENT_BUS, event_bus_stats);
+        SOURCE(STATS_TURBO_REPEAT, turbo_repeat_stats);
+        SOURCE(STATS_KEY_HEATMAP, key_heatmap_stats);
+        SOURCE(STATS_PROFILE_BANK, profile_bank_stats);
+        SOURCE(STATS_FLASH_STORE, flash_store_stats);
+        SOURCE(STATS_USB_SUSPEND, usb_suspend_stats);
+#ifdef MATRIX_SAMPLER
+        SOURCE(STATS_MATRIX_SAMPLER, matrix_sampler_stats); // čítače mění přerušení, část se může přečíst rozpracovaná
+#endif
+#ifdef OLED_ENABLE
+        SOURCE(STATS_OLED_PREFETCH, oled_prefetch_stats);
+        SOURCE(STATS_OLED_TEXT, oled_text_stats);
+        SOURCE(STATS_OLED_GRAY, oled_gray_stats);
+        SOURCE(STATS_OLED_I2C, oled_i2c_stats);
+        SOURCE(STATS_OLED_SAVER, oled_saver_stats);
+        SOURCE(STATS_OLED_ANIM, oled_anim_stats);
+        SOURCE(STATS_OLED_FB, oled_fb_stats);
+        SOURCE(STATS_OLED_LEGEND, oled_legend_stats);
+#endif
+        default:
+            *size = 0;
+            return NULL;
+    }
+}
+
+void stats_report_command(uint8_t *data) {
+    uint8_t        id     = data[1];
+    uint8_t        offset = data[2];
+    uint8_t        size;
+    const uint8_t *stats  = source(id, &size);
+
+    data[3] = size;
+    data[4] = offset;
+
+    if (id >= STATS_SOURCES || offset > size) {
+        data[2] = RAW_HID_INVALID;
+        return;
+    }
+
+    uint8_t length = size - offset;
+    if (length > STATS_CHUNK) length = STATS_CHUNK;
+    if (length) memcpy(&data[5], stats + offset, length);
+
+    data[2] = RAW_HID_OK;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+// Čítače modulů (*_stats()) pro hostitele přes raw HID. Struktura se posílá tak, jak
+// leží v RAM (little endian, zarovnání ARM), rozkládá ji tools/stats_dump.py. Delší
+// struktury se čtou po částech od zadaného offsetu.
+// [0x45, zdroj, offset] -> [0x45, zdroj, stav, velikost struktury, offset, data (nejvíc STATS_CHUNK B)]
+// Zdroj, který v sestavení není (např. matrix_sampler bez MATRIX_SAMPLER), má velikost 0.
+
+#define STATS_CHUNK 27 // 32 B report - 5 B hlavička
+
+enum stats_sources { // jen přidávat na konec, stats_dump.py zná čísla
+    STATS_REPORT_COALESCE = 0,
+    STATS_IDLE_SLEEP      = 1,
+    STATS_BOOT_STAGE      = 2,
+    STATS_OLED_PREFETCH   = 3,
+    STATS_OLED_TEXT       = 4,
+    STATS_OLED_GRAY       = 5,
+    STATS_OLED_I2C        = 6,
+    STATS_MATRIX_SAMPLER  = 7,
+    STATS_OLED_SAVER      = 8,
+    STATS_EVENT_BUS       = 9,
+    STATS_TURBO_REPEAT    = 10,
+    STATS_OLED_ANIM       = 11,
+    STATS_OLED_FB         = 12,
+    STATS_OLED_LEGEND     = 13,
+    STATS_KEY_HEATMAP     = 14,
+    STATS_PROFILE_BANK    = 15,
+    STATS_FLASH_STORE     = 16,
+    STATS_USB_SUSPEND     = 17,
+    STATS_SOURCES,
+};
+
+void stats_report_command(uint8_t *data); // raw HID, odpověď se zapíše do data
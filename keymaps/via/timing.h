@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "hardware/structs/timer.h"
+
+// mikrosekundový čas z hardwarového časovače RP2040 (běží od resetu, přetéká po ~71 minutách)
+static inline uint32_t timing_us(void) {
+    return timer_hw->timerawl;
+}
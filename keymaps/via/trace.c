@@ -0,0 +1,65 @@
+#include QMK_KEYBOARD_H
+
+#include "trace.h"
+#include "timing.h"
+#include "ram_watch.h"
+
+_Static_assert((TRACE_RING_SIZE & (TRACE_RING_SIZE - 1)) == 0, "TRACE_RING_SIZE musí být mocnina dvou");
+_Static_assert(TRACE_ID_COUNT <= 256, "ID události se posílá v jednom bajtu");
+
+#define RECORD_BYTES 13 // čas (4) + ID (1) + dva argumenty (2 x 4), bez zarovnání
+
+typedef struct {
+    uint32_t time_us;
+    uint32_t args[2];
+    uint8_t  id;
+} trace_record_t;
+
+#if TRACE_LEVEL != TRACE_OFF
+static trace_record_t ring[TRACE_RING_SIZE];
+RAM_ACCOUNT(sizeof(ring), TRACE_RAM);
+static uint16_t       head    = 0; // volně běžící indexy, maskují se při přístupu
+static uint16_t       tail    = 0;
+static uint16_t       dropped = 0; // přepsané záznamy od posledního čtení
+#endif
+
+void trace_write(trace_id_t id, uint32_t a, uint32_t b) {
+#if TRACE_LEVEL != TRACE_OFF
+    if ((uint16_t)(head - tail) == TRACE_RING_SIZE) { // plný ring: nejstarší záznam se zahodí
+        tail++;
+        if (dropped != UINT16_MAX) dropped++;
+    }
+
+    trace_record_t *record = &ring[head & (TRACE_RING_SIZE - 1)];
+
+    record->time_us = timing_us();
+    record->id      = id;
+    record->args[0] = a;
+    record->args[1] = b;
+    head++;
+#endif
+}
+
+void trace_command(uint8_t *data, uint8_t length) {
+    uint8_t count = 0;
+    uint8_t room  = (length - 4) / RECORD_BYTES;
+
+#if TRACE_LEVEL != TRACE_OFF
+    memcpy(&data[2], &dropped, sizeof(dropped));
+    dropped = 0;
+
+    for (; count < room && tail != head; count++, tail++) {
+        const trace_record_t *record = &ring[tail & (TRACE_RING_SIZE - 1)];
+        uint8_t              *out    = &data[4 + count * RECORD_BYTES];
+
+        memcpy(out, &record->time_us, 4);
+        out[4] = record->id;
+        memcpy(out + 5, record->args, 8);
+    }
+#else
+    (void)room;
+    memset(&data[2], 0, 2);
+#endif
+
+    data[1] = count;
+}
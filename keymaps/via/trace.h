@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+
+// Binární trasování: do kruhového bufferu v RAM se ukládá jen čas, ID události a dva
+// surové argumenty, text se skládá až na hostiteli (tools/trace_decode.py). Události
+// nad TRACE_LEVEL se vypustí už při překladu, argumenty se pak ani nevyhodnotí.
+
+#define TRACE_OFF 0
+#define TRACE_INFO 1
+#define TRACE_DEBUG 2
+#define TRACE_VERBOSE 3
+
+#ifndef TRACE_LEVEL
+#    define TRACE_LEVEL TRACE_OFF
+#endif
+#ifndef TRACE_RING_SIZE
+#    define TRACE_RING_SIZE 128 // záznamů, mocnina dvou
+#endif
+#define TRACE_RAM (TRACE_LEVEL == TRACE_OFF ? 0 : TRACE_RING_SIZE * 16) // bez trasování se ring nepřekládá
+
+typedef enum {
+#define TRACE_EVENT(name, level, format) TRACE_ID_##name,
+#include "trace_events.h"
+#undef TRACE_EVENT
+    TRACE_ID_COUNT,
+} trace_id_t;
+
+enum {
+#define TRACE_EVENT(name, level, format) TRACE_LVL_##name = level,
+#include "trace_events.h"
+#undef TRACE_EVENT
+};
+
+#define TRACE(name, a, b)                                                   \
+    do {                                                                    \
+        if (TRACE_LVL_##name <= TRACE_LEVEL) {                              \
+            trace_write(TRACE_ID_##name, (uint32_t)(a), (uint32_t)(b));     \
+        }                                                                   \
+    } while (0)
+
+void trace_write(trace_id_t id, uint32_t a, uint32_t b); // jen z hlavní smyčky, ne z přerušení
+
+// raw HID: [0x42] -> [0x42, počet záznamů, ztracené (uint16), záznamy po 13 B: čas µs, ID, a, b]
+void trace_command(uint8_t *data, uint8_t length);
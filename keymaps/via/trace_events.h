@@ -0,0 +1,22 @@
+// Tabulka událostí trasování: TRACE_EVENT(jméno, úroveň, formát pro hostitele).
+// Pořadí určuje ID, tools/trace_decode.py si z tohoto souboru generuje tabulku
+// ID -> formát, takže nové události se přidávají jen na konec. Formát je pro Python
+// str.format(), {0} a {1} jsou dva argumenty záznamu.
+// Soubor se vkládá opakovaně (X-makro), proto nemá #pragma once.
+
+TRACE_EVENT(CYCLE_PRESS, TRACE_DEBUG, "cycle press, taps so far {0}")
+TRACE_EVENT(CYCLE_RELEASE, TRACE_DEBUG, "cycle release, tap {0}, settings held {1}")
+TRACE_EVENT(CYCLE_HOLD, TRACE_DEBUG, "cycle hold -> settings layer")
+TRACE_EVENT(CYCLE_RESOLVE, TRACE_DEBUG, "cycle gesture {0} taps -> layer {1}")
+TRACE_EVENT(LAYER_STATE, TRACE_INFO, "layer state 0x{0:x} -> 0x{1:x}")
+TRACE_EVENT(HAPTIC_PULSE, TRACE_INFO, "haptic pulse, dwell {0} ms")
+TRACE_EVENT(OLED_FLUSH, TRACE_VERBOSE, "oled flush {0} pages in {1} us")
+TRACE_EVENT(TURBO_REPEAT, TRACE_DEBUG, "turbo repeat keycode 0x{0:04x}, next in {1} ms")
+TRACE_EVENT(OLED_SAVER, TRACE_INFO, "oled saver stage {0}, value {1}")
+TRACE_EVENT(PROFILE_SWITCH, TRACE_INFO, "profile {0} active, switch took {1} us")
+TRACE_EVENT(USB_SUSPEND, TRACE_INFO, "usb suspend #{0}, display and solenoid powered down")
+TRACE_EVENT(USB_RESUME_PIXELS, TRACE_INFO, "usb resume -> frame restored in {0} us")
+TRACE_EVENT(USB_RESUME_REPORT, TRACE_INFO, "usb resume -> first report in {0} us, queued so far {1}")
+TRACE_EVENT(EVENT_DROPPED, TRACE_INFO, "event bus queue full, dropped event {0} (value 0x{1:x})")
+TRACE_EVENT(EVENT_SUBSCRIBE_FAILED, TRACE_INFO, "event bus subscription to event {0} rejected, {1} subscribers")
+TRACE_EVENT(STACK_HIGH_WATER, TRACE_INFO, "stack {0} high-water mark {1} B")
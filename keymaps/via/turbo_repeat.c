@@ -0,0 +1,137 @@
+#include QMK_KEYBOARD_H
+
+#include "turbo_repeat.h"
+#include "trace.h"
+
+// Zrychlující se opakování držené klávesy. Klávesa s profilem se hostiteli nikdy
+// nedrží (žádný typematic OS), posílá se jako tapy: jeden hned při stisku a další
+// z deferred exec. Ten přičítá vrácený interval k plánovanému času, ne k času
+// zavolání, takže zpoždění průchodu smyčkou se nesčítá a časy tapů jsou dané jen
+// profilem. Interval se počítá z plánovaného času, stejný profil tak dá vždy
+// stejnou řadu časů (ověřitelnou z trasování TURBO_REPEAT).
+
+typedef struct {
+    turbo_profile_t profile;
+    keypos_t        key;        // puštění se páruje podle pozice, vrstva se mezitím mohla změnit
+    deferred_token  token;      // INVALID_DEFERRED_TOKEN = volný slot
+    uint32_t        ramp_start; // plánovaný čas prvního opakování
+} turbo_slot_t;
+
+static turbo_slot_t  slots[TURBO_MAX_ACTIVE] = {[0 ... TURBO_MAX_ACTIVE - 1] = {.token = INVALID_DEFERRED_TOKEN}};
+static turbo_stats_t stats;
+
+uint16_t turbo_repeat_interval(const turbo_profile_t *profile, uint32_t ramp_elapsed_ms) {
+
+    uint32_t ramp = profile->ramp_ms ? profile->ramp_ms : 1;
+
+    if (ramp_elapsed_ms > ramp) {
+        ramp_elapsed_ms = ramp;
+    }
+
+    // frekvence lineárně v čase: f = start + (max - start) * t / ramp, interval = 1000 / f,
+    // počítáno bez dělení uprostřed, aby se frekvence nezaokrouhlovala na celé Hz
+    uint32_t hz_ms = profile->start_hz * ramp + ((int32_t)profile->max_hz - profile->start_hz) * (int32_t)ramp_elapsed_ms;
+
+    if (hz_ms == 0) {
+        return 1000;
+    }
+
+    uint32_t interval = (1000 * ramp + hz_ms / 2) / hz_ms;
+
+    return interval ? interval : 1;
+}
+
+static uint32_t repeat_tap(uint32_t trigger_time, void *cb_arg) {
+
+    turbo_slot_t *slot = cb_arg;
+
+    tap_code16(slot->profile.keycode);
+
+    uint32_t late = timer_read32() - trigger_time;
+
+    if (late > stats.late_max_ms) {
+        stats.late_max_ms = late;
+    }
+    stats.repeats++;
+
+    uint16_t interval = turbo_repeat_interval(&slot->profile, trigger_time - slot->ramp_start);
+
+    stats.last_interval_ms = interval;
+
+    TRACE(TURBO_REPEAT, slot->profile.keycode, interval);
+
+    return interval; // další tap = trigger_time + interval
+}
+
+static turbo_slot_t *find_slot(keypos_t key) {
+
+    for (uint8_t i = 0; i < TURBO_MAX_ACTIVE; i++) {
+        if (slots[i].token != INVALID_DEFERRED_TOKEN && slots[i].key.row == key.row && slots[i].key.col == key.col) {
+            return &slots[i];
+        }
+    }
+    return NULL;
+}
+
+static bool find_profile(uint16_t keycode, turbo_profile_t *profile) {
+
+    for (uint8_t i = 0; i < turbo_profile_count; i++) {
+        if (pgm_read_word(&turbo_profiles[i].keycode) == keycode) {
+            memcpy_P(profile, &turbo_profiles[i], sizeof(*profile));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool process_turbo_repeat(uint16_t keycode, keyrecord_t *record) {
+
+    if (!record->event.pressed) {
+
+        turbo_slot_t *slot = find_slot(record->event.key);
+
+        if (slot == NULL) {
+            return true; // klávesa bez opakování (nebo stisk neměl volný slot)
+        }
+
+        cancel_deferred_exec(slot->token);
+        slot->token = INVALID_DEFERRED_TOKEN;
+
+        return false; // tapy už jsou odeslané, není co pouštět
+    }
+
+    turbo_profile_t profile;
+
+    if (!find_profile(keycode, &profile)) {
+        return true;
+    }
+
+    turbo_slot_t *slot = NULL;
+
+    for (uint8_t i = 0; i < TURBO_MAX_ACTIVE && slot == NULL; i++) {
+        if (slots[i].token == INVALID_DEFERRED_TOKEN) {
+            slot = &slots[i];
+        }
+    }
+
+    if (slot == NULL) {
+        return true; // všechny sloty obsazené: obyčejná klávesa
+    }
+
+    slot->profile    = profile;
+    slot->key        = record->event.key;
+    slot->ramp_start = timer_read32() + profile.delay_ms;
+    slot->token      = defer_exec(profile.delay_ms, repeat_tap, slot);
+
+    if (slot->token == INVALID_DEFERRED_TOKEN) {
+        return true; // deferred exec plný, třeba podržený KC_CYCLE_LAYERS: obyčejná klávesa
+    }
+
+    tap_code16(keycode);
+
+    return false;
+}
+
+const turbo_stats_t *turbo_repeat_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef TURBO_MAX_ACTIVE
+#    define TURBO_MAX_ACTIVE 4 // najednou držených kláves s opakováním, každá si bere jeden deferred exec
+#endif
+
+typedef struct {
+    uint16_t keycode;  // keycode, který se při držení opakuje (i s modifikátory)
+    uint16_t delay_ms; // první opakování po stisku, do té doby je to obyčejný tap
+    uint8_t  start_hz; // frekvence prvního opakování
+    uint8_t  max_hz;   // frekvence po zrychlení
+    uint16_t ramp_ms;  // doba lineárního zrychlení ze start_hz na max_hz
+} turbo_profile_t;
+
+typedef struct {
+    uint32_t repeats;          // odeslané opakované tapy
+    uint32_t late_max_ms;      // největší zpoždění tapu za plánovaným časem (průchod smyčkou)
+    uint16_t last_interval_ms; // poslední naplánovaný interval
+} turbo_stats_t;
+
+// definuje keymap.c
+extern const turbo_profile_t turbo_profiles[];
+extern const uint8_t         turbo_profile_count;
+
+bool     process_turbo_repeat(uint16_t keycode, keyrecord_t *record); // false = událost pohlcena
+uint16_t turbo_repeat_interval(const turbo_profile_t *profile, uint32_t ramp_elapsed_ms);
+
+const turbo_stats_t *turbo_repeat_stats(void);
@@ -0,0 +1,145 @@
+#include QMK_KEYBOARD_H
+
+#include "hardware/gpio.h"
+#include "usb_device_state.h"
+
+#include "usb_suspend.h"
+#include "boot_stage.h"
+#include "report_coalesce.h"
+#include "timing.h"
+#include "trace.h"
+#ifdef OLED_ENABLE
+#    include "oled_fb.h"
+#    include "oled_i2c.h"
+#endif
+
+// Uspání hostitelem: displej se vypne i s nábojovou pumpou (RAM řadiče zůstává)
+// a pin solenoidu se přepne na vstup s pull-down, takže budič nemůže sepnout ani
+// z rozpracovaného pulzu. Po probuzení se nic znovu neinicializuje: pumpa se zapne
+// a poslední hotový snímek z RAM (front buffer) odejde jedním flushem. Reporty
+// vzniklé dřív, než je USB zase nakonfigurované, drží report_coalesce ve frontě,
+// takže se stisk, který pad probudil, neztratí.
+
+#define SSD1306_DISPLAY_OFF 0xAE
+#define SSD1306_CHARGE_PUMP 0x8D
+#define SSD1306_CHARGE_PUMP_OFF 0x10
+#define SSD1306_CHARGE_PUMP_ON 0x14
+#define SSD1306_SCROLL_DEACTIVATE 0x2E // scroll spořiče by po probuzení posouval obnovený obraz
+
+static bool     suspended       = false;
+static bool     restore_pending = false; // displej čeká na obnovu
+static bool     report_pending  = false; // čeká se na první report po probuzení
+static uint32_t wake_us         = 0;
+static uint32_t wake_ms         = 0; // last_input_activity je v ms
+static uint32_t reports_at_wake = 0;
+
+static usb_suspend_stats_t stats;
+
+static void park_solenoid(void) {
+    gpio_put(SOLENOID_PIN, 0);
+    gpio_set_dir(SOLENOID_PIN, GPIO_IN);
+    gpio_pull_down(SOLENOID_PIN); // gate budiče drží dole pull-down, výstup nic nenapájí
+}
+
+static void unpark_solenoid(void) { // stejný stav jako po haptic_init
+    gpio_disable_pulls(SOLENOID_PIN);
+    gpio_put(SOLENOID_PIN, 0);
+    gpio_set_dir(SOLENOID_PIN, GPIO_OUT);
+}
+
+void usb_suspend_power_down(void) {
+    if (suspended) return;
+
+    suspended = true;
+    stats.suspends++;
+
+    report_coalesce_flush();     // co vzniklo před uspáním, ještě odejde
+    report_coalesce_hold(true);  // další reporty až po probuzení
+
+    park_solenoid(); // solenoid inicializuje jádro už v keyboard_init
+#ifdef OLED_ENABLE
+    if (boot_stage_reached(BOOT_STAGE_OLED)) { // dřív displej ještě nic neukazuje
+        const uint8_t commands[] = {SSD1306_DISPLAY_OFF, SSD1306_CHARGE_PUMP, SSD1306_CHARGE_PUMP_OFF};
+
+        oled_off(); // QMK ví, že je displej zhasnutý, flush ho pak rozsvítí přes oled_on()
+        oled_i2c_send_commands(commands, sizeof(commands));
+    }
+#endif
+
+    TRACE(USB_SUSPEND, stats.suspends, 0);
+}
+
+void usb_suspend_wakeup(void) { // jen značky, práce s I2C a GPIO až v usb_suspend_task
+    if (!suspended) return;
+
+    suspended       = false;
+    wake_us         = timing_us();
+    wake_ms         = timer_read32();
+    reports_at_wake = report_coalesce_stats()->reports_sent;
+    restore_pending = true;
+    report_pending  = true;
+    stats.resumes++;
+}
+
+static void restore(void) {
+    restore_pending = false;
+
+    unpark_solenoid();
+#ifdef OLED_ENABLE
+    if (!boot_stage_reached(BOOT_STAGE_OLED)) return; // první snímek ještě pošle boot_stage
+
+    const uint8_t commands[] = {SSD1306_CHARGE_PUMP, SSD1306_CHARGE_PUMP_ON, SSD1306_SCROLL_DEACTIVATE};
+
+    oled_i2c_send_commands(commands, sizeof(commands));
+    oled_fb_resend();
+    oled_fb_flush(OLED_FB_PAGES); // celý poslední snímek najednou, oled_on() pošle flush sám
+
+    uint32_t latency = timing_us() - wake_us;
+
+    stats.resume_pixels_last_us = latency;
+    if (latency > stats.resume_pixels_max_us) stats.resume_pixels_max_us = latency;
+
+    TRACE(USB_RESUME_PIXELS, latency, 0);
+#endif
+}
+
+static void track_report_latency(void) {
+    const report_stats_t *reports = report_coalesce_stats();
+
+    if (!report_pending) return;
+
+    if (timer_elapsed32(wake_ms) > USB_RESUME_KEY_WINDOW_MS) { // probudil hostitel, ne klávesa
+        report_pending = false;
+        return;
+    }
+    if (reports->reports_sent == reports_at_wake) return;
+
+    if (last_input_activity_elapsed() > timer_elapsed32(wake_ms)) { // prázdný report, který QMK posílá po probuzení
+        reports_at_wake = reports->reports_sent;
+        return;
+    }
+
+    uint32_t latency = reports->last_report_us - wake_us;
+
+    stats.resume_report_last_us = latency;
+    if (latency > stats.resume_report_max_us) stats.resume_report_max_us = latency;
+    report_pending = false;
+
+    TRACE(USB_RESUME_REPORT, latency, reports->reports_queued);
+}
+
+void usb_suspend_task(void) {
+    if (suspended) return;
+
+    if (restore_pending) restore();
+
+    if (usb_device_state == USB_DEVICE_STATE_CONFIGURED) {
+        report_coalesce_hold(false); // fronta odejde ve stejném pořadí, v jakém vznikla
+    }
+
+    track_report_latency();
+}
+
+const usb_suspend_stats_t *usb_suspend_stats(void) {
+    return &stats;
+}
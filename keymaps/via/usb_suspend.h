@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef USB_RESUME_KEY_WINDOW_MS
+#    define USB_RESUME_KEY_WINDOW_MS 1000 // stisk do této doby po probuzení se počítá do latence prvního reportu
+#endif
+
+typedef struct {
+    uint32_t suspends;
+    uint32_t resumes;
+    uint32_t resume_pixels_last_us;  // probuzení -> obnovený obraz (jeden flush celého snímku)
+    uint32_t resume_pixels_max_us;
+    uint32_t resume_report_last_us;  // probuzení -> první odeslaný report
+    uint32_t resume_report_max_us;
+} usb_suspend_stats_t;
+
+void usb_suspend_power_down(void); // ze suspend_power_down_user, volá se opakovaně po celou dobu uspání
+void usb_suspend_wakeup(void);     // ze suspend_wakeup_init_user
+void usb_suspend_task(void);       // v housekeeping před report_coalesce_task: obnova displeje a uvolnění reportů
+
+const usb_suspend_stats_t *usb_suspend_stats(void);
@@ -0,0 +1,188 @@
+#include QMK_KEYBOARD_H
+
+#include "via.h"
+#include "solenoid.h"
+
+#include "user_settings.h"
+#include "keymap_user.h"
+#include "oled_rotate.h"
+#include "ram_watch.h"
+#include "profile_bank.h"
+#ifdef OLED_ENABLE
+#    include "oled_fb.h"
+#endif
+#ifdef MATRIX_SAMPLER
+#    include "matrix_sampler.h"
+#endif
+
+// Časování z VIA (menu ve via.json). Změna se zapíše jen do RAM a hned platí,
+// úložiště (wear-leveling EEPROM ve flash, zápis blokuje XIP) se zapisuje až
+// USER_SETTINGS_SAVE_IDLE_MS po poslední změně a stisku. Blok s jinou verzí se
+// nepoužije a platí výchozí hodnoty z config.h.
+
+#ifndef OLED_FB_ORIENTATION
+#    define OLED_FB_ORIENTATION OLED_ORIENT_0
+#endif
+#ifdef MATRIX_SAMPLER
+#    define DEFAULT_DEBOUNCE MATRIX_SAMPLER_DEBOUNCE
+#else
+#    ifndef DEBOUNCE
+#        define DEBOUNCE 5
+#    endif
+#    define DEFAULT_DEBOUNCE DEBOUNCE
+#endif
+
+#define HOLD_DELAY_MIN 300
+#define HOLD_DELAY_MAX 5000
+#define TAP_WINDOW_MIN 50
+#define TAP_WINDOW_MAX 500
+#define DEBOUNCE_MAX 30
+#define DWELL_MAX 100 // dwell má v konfiguraci haptiky QMK jen 7 bitů
+#define ORIENTATION_MAX OLED_ORIENT_MIRROR_Y // 90° a 270° potřebují snímky kreslené na výšku
+
+_Static_assert(sizeof(user_settings_t) <= EECONFIG_USER_DATA_SIZE, "EECONFIG_USER_DATA_SIZE je menší než user_settings_t");
+
+user_settings_t user_settings = {
+    .version       = USER_SETTINGS_VERSION,
+    .debounce_ms   = DEFAULT_DEBOUNCE,
+    .hold_delay_ms = HOLD_MODIFIER_LAYER_DELAY,
+    .tap_window_ms = LAYER_TAP_WINDOW,
+    .orientation   = OLED_FB_ORIENTATION,
+};
+
+static bool     dirty       = false;
+static bool     dwell_dirty = false; // dwell se ukládá přes haptiku QMK
+static uint32_t changed_ms  = 0;
+RAM_ACCOUNT(sizeof(user_settings) + sizeof(dirty) + sizeof(dwell_dirty) + sizeof(changed_ms), USER_SETTINGS_RAM);
+
+static uint16_t clamp(uint16_t value, uint16_t min, uint16_t max) {
+    return value < min ? min : value > max ? max : value;
+}
+
+static void apply(void) { // hodnoty, které nečte hlavní smyčka sama z user_settings
+#ifdef MATRIX_SAMPLER
+    matrix_sampler_set_debounce(user_settings.debounce_ms);
+#endif
+#ifdef OLED_ENABLE
+    oled_fb_set_orientation(user_settings.orientation);
+#endif
+}
+
+void user_settings_init(void) {
+    user_settings_t stored;
+
+    eeconfig_read_user_datablock(&stored, 0, sizeof(stored));
+
+    if (stored.version == USER_SETTINGS_VERSION) { // jiná verze = nový nebo starý blok, zůstanou výchozí hodnoty
+        user_settings.debounce_ms   = clamp(stored.debounce_ms, 0, DEBOUNCE_MAX);
+        user_settings.hold_delay_ms = clamp(stored.hold_delay_ms, HOLD_DELAY_MIN, HOLD_DELAY_MAX);
+        user_settings.tap_window_ms = clamp(stored.tap_window_ms, TAP_WINDOW_MIN, TAP_WINDOW_MAX);
+        user_settings.orientation   = clamp(stored.orientation, 0, ORIENTATION_MAX);
+        user_settings.profile       = stored.profile; // rozsah ověří profile_bank_init
+    }
+
+    apply();
+}
+
+void user_settings_task(void) {
+    if (!dirty && !dwell_dirty) return;
+    if (timer_elapsed32(changed_ms) < USER_SETTINGS_SAVE_IDLE_MS) return;
+    if (last_input_activity_elapsed() < USER_SETTINGS_SAVE_IDLE_MS) return;
+
+    if (dirty) {
+        eeconfig_update_user_datablock(&user_settings, 0, sizeof(user_settings));
+        dirty = false;
+    }
+    if (dwell_dirty) {
+        profile_bank_haptic_save_begin(); // na bance se uloží dwell profilu 0, ne banky
+        haptic_set_dwell(haptic_config.dwell); // jen zápis konfigurace haptiky, solenoid už dwell dostal v set_value
+        profile_bank_haptic_save_end();
+        dwell_dirty = false;
+    }
+}
+
+void user_settings_changed(void) {
+    dirty      = true;
+    changed_ms = timer_read32();
+}
+
+static void set_value(uint8_t id, const uint8_t *value) {
+    uint16_t wide = (value[0] << 8) | value[1];
+
+    switch (id) {
+        case SETTINGS_HOLD_DELAY:
+            user_settings.hold_delay_ms = clamp(wide, HOLD_DELAY_MIN, HOLD_DELAY_MAX);
+            break;
+        case SETTINGS_TAP_WINDOW:
+            user_settings.tap_window_ms = clamp(wide, TAP_WINDOW_MIN, TAP_WINDOW_MAX);
+            break;
+        case SETTINGS_DWELL:
+            profile_bank_haptic_save_begin(); // úprava na bance patří i profilu 0, který se později uloží
+            haptic_config.dwell = clamp(value[0], SOLENOID_MIN_DWELL, DWELL_MAX);
+            solenoid_set_dwell(haptic_config.dwell); // driver solenoidu má vlastní kopii, haptic_config čte jen haptic_init
+            profile_bank_haptic_save_end();
+            dwell_dirty         = true;
+            changed_ms          = timer_read32();
+            haptic_settings_changed();
+            return;
+        case SETTINGS_DEBOUNCE:
+            user_settings.debounce_ms = clamp(value[0], 0, DEBOUNCE_MAX);
+            break;
+        case SETTINGS_ORIENTATION:
+            user_settings.orientation = clamp(value[0], 0, ORIENTATION_MAX);
+            break;
+        default:
+            return;
+    }
+
+    apply();
+    user_settings_changed();
+}
+
+static void get_value(uint8_t id, uint8_t *value) {
+    switch (id) {
+        case SETTINGS_HOLD_DELAY:
+            value[0] = user_settings.hold_delay_ms >> 8;
+            value[1] = user_settings.hold_delay_ms & 0xFF;
+            break;
+        case SETTINGS_TAP_WINDOW:
+            value[0] = user_settings.tap_window_ms >> 8;
+            value[1] = user_settings.tap_window_ms & 0xFF;
+            break;
+        case SETTINGS_DWELL:
+            value[0] = haptic_config.dwell;
+            break;
+        case SETTINGS_DEBOUNCE:
+            value[0] = user_settings.debounce_ms;
+            break;
+        case SETTINGS_ORIENTATION:
+            value[0] = user_settings.orientation;
+            break;
+    }
+}
+
+void user_settings_via_command(uint8_t *data, uint8_t length) { // [příkaz, kanál, value_id, hodnota...]
+    uint8_t *command = &data[0];
+    uint8_t  channel = data[1];
+    uint8_t  id      = data[2];
+    uint8_t *value   = &data[3];
+
+    if (channel != id_custom_channel) {
+        *command = id_unhandled;
+        return;
+    }
+
+    switch (*command) {
+        case id_custom_set_value:
+            set_value(id, value);
+            break;
+        case id_custom_get_value:
+            get_value(id, value);
+            break;
+        case id_custom_save: // zápis stejně proběhne líně, až se přestane měnit
+            break;
+        default:
+            *command = id_unhandled;
+            break;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define USER_SETTINGS_VERSION 1 // zvýšit při změně user_settings_t, starý blok se pak převede nebo zahodí
+
+#ifndef HOLD_MODIFIER_LAYER_DELAY
+#    define HOLD_MODIFIER_LAYER_DELAY 2000 // výchozí zpoždění pro aktivaci settings vrstvy (v ms)
+#endif
+#ifndef LAYER_TAP_WINDOW
+#    define LAYER_TAP_WINDOW 200 // výchozí okno na další tap KC_CYCLE_LAYERS (v ms), po něm se gesto vyhodnotí
+#endif
+
+#ifndef USER_SETTINGS_SAVE_IDLE_MS
+#    define USER_SETTINGS_SAVE_IDLE_MS 1000 // zápis až po této době bez změny z VIA a bez stisku
+#endif
+
+// Nastavení měnitelná za běhu z VIA. Hodnoty se čtou přímo z RAM (user_settings),
+// úložiště se čte jen při startu a zapisuje se líně. Dwell solenoidu drží QMK
+// v konfiguraci haptiky, sem nepatří.
+typedef struct {
+    uint8_t  version;       // USER_SETTINGS_VERSION
+    uint8_t  debounce_ms;
+    uint16_t hold_delay_ms; // podržení KC_CYCLE_LAYERS pro settings vrstvu
+    uint16_t tap_window_ms; // okno na další tap KC_CYCLE_LAYERS
+    uint8_t  orientation;   // oled_orient_t
+    uint8_t  profile;       // aktivní profil (profile_bank.c), ve verzi 1 dřív rezervovaný a nulový
+} user_settings_t;
+
+#define USER_SETTINGS_RAM (sizeof(user_settings_t) + 2 * sizeof(bool) + sizeof(uint32_t)) // nastavení + stav líného zápisu
+
+// value_id položek menu ve via.json, kanál id_custom_channel
+enum user_settings_values {
+    SETTINGS_HOLD_DELAY = 1, // 2 B big-endian, ms
+    SETTINGS_TAP_WINDOW,     // 2 B big-endian, ms
+    SETTINGS_DWELL,          // 1 B, ms
+    SETTINGS_DEBOUNCE,       // 1 B, ms
+    SETTINGS_ORIENTATION,    // 1 B, oled_orient_t
+};
+
+extern user_settings_t user_settings;
+
+void user_settings_init(void); // načte blok z EEPROM a uplatní ho, jako první v keyboard_post_init_user
+void user_settings_task(void); // líný zápis změn
+void user_settings_changed(void); // pole změněné mimo VIA, zapíše se stejně líně
+void user_settings_via_command(uint8_t *data, uint8_t length); // id_custom_* z VIA, odpověď se zapíše do data
@@ -0,0 +1,104 @@
+// chord_engine.c: cena rozhodnutí chordu podle počtu chordů ve vrstvě, proti
+// lineárnímu průchodu tabulkou. Jen měří a vypisuje, nic nekontroluje.
+//
+//   make -C tests bench
+
+#include "chord_engine.c"
+#include "test.h"
+
+#include <time.h>
+
+#define ROUNDS 2000
+
+// vrstva n má SIZES[n] chordů; masky i * 1237 mod 2047 + 1 jsou pro i < 2047 různé
+#define MASK(i) ((uint16_t)((i) * 1237 % 2047 + 1))
+#define LAYERS_OF(i) (((i) < 8 ? 0x1 : 0) | ((i) < 32 ? 0x2 : 0) | ((i) < 64 ? 0x4 : 0) | ((i) < 128 ? 0x8 : 0))
+#define E(i) {MASK(i), KC_A + (i) % 26, LAYERS_OF(i)},
+#define R8(i) E(i) E(i + 1) E(i + 2) E(i + 3) E(i + 4) E(i + 5) E(i + 6) E(i + 7)
+#define R64(i) R8(i) R8(i + 8) R8(i + 16) R8(i + 24) R8(i + 32) R8(i + 40) R8(i + 48) R8(i + 56)
+
+const chord_t PROGMEM chords[] = {R64(0) R64(64)};
+const uint16_t        chord_count = ARRAY_SIZE(chords);
+
+static const uint8_t SIZES[] = {8, 32, 64, 128};
+
+static const keypos_t positions[KEY_COUNT] = {
+    {0, 0}, {1, 0}, {2, 0}, {3, 0}, {0, 1}, {1, 1}, {2, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2},
+};
+
+static void key(uint8_t index, bool pressed) {
+    keyrecord_t record = {.event = {.key = positions[index], .time = fake_ms, .pressed = pressed}};
+
+    process_chord(KC_NO, &record);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static volatile uint16_t sink;
+
+static uint16_t linear_lookup(uint16_t mask, uint8_t layer) { // původní přístup: průchod všemi chordy
+    for (uint16_t i = 0; i < chord_count; i++) {
+        if (chords[i].mask == mask && (chords[i].layers & CHORD_LAYER(layer))) return chords[i].keycode;
+    }
+    return KC_NO;
+}
+
+// stisky a puštění všech chordů vrstvy, vrací ns na jedno rozhodnutí
+static double bench_process(uint8_t layer, uint8_t size) {
+    uint32_t resolves = 0;
+    uint64_t start    = now_ns();
+
+    for (uint16_t round = 0; round < ROUNDS; round++) {
+        for (uint8_t i = 0; i < size; i++) {
+            uint16_t mask = MASK(i);
+
+            for (uint8_t k = 0; k < KEY_COUNT; k++) {
+                if (mask & CHORD_KEY(k)) key(k, true);
+            }
+            resolve(); // delší chord s touto maskou jako podmnožinou by jinak čekal na CHORD_TERM
+            for (uint8_t k = 0; k < KEY_COUNT; k++) {
+                if (mask & CHORD_KEY(k)) key(k, false);
+            }
+            resolves++;
+        }
+        fake_log_count = 0;
+    }
+    return (double)(now_ns() - start) / resolves;
+}
+
+static double bench_lookup(uint8_t layer, uint8_t size, bool linear) {
+    uint32_t lookups = 0;
+    uint64_t start   = now_ns();
+
+    for (uint16_t round = 0; round < ROUNDS * 4; round++) {
+        for (uint8_t i = 0; i < size; i++) {
+            sink = linear ? linear_lookup(MASK(i), layer) : chord_lookup(MASK(i));
+            lookups++;
+        }
+    }
+    return (double)(now_ns() - start) / lookups;
+}
+
+int main(void) {
+    printf("%s: chordů  půlení  ns/rozhodnutí  ns/hledání  ns/lineárně\n", __FILE__);
+
+    for (uint8_t layer = 0; layer < ARRAY_SIZE(SIZES); layer++) {
+        fake_reset();
+        build(layer);
+
+        uint8_t steps = 0; // kroky binárního hledání v nejhorším případě
+        while ((1u << steps) <= chord_total) steps++;
+
+        double process = bench_process(layer, SIZES[layer]);
+        double lookup  = bench_lookup(layer, SIZES[layer], false);
+        double linear  = bench_lookup(layer, SIZES[layer], true);
+
+        printf("%s: %6u  %6u  %13.1f  %10.1f  %11.1f\n", __FILE__, chord_total, steps, process, lookup, linear);
+    }
+    return 0;
+}
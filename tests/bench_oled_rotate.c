@@ -0,0 +1,97 @@
+// oled_rotate.c: otočení stránky o 90° po blocích přes transpose8 proti naivnímu
+// přenosu pixel po pixelu. Jen měří a vypisuje, nic nekontroluje.
+//
+//   make -C tests bench
+
+#include "oled_rotate.c"
+#include "test.h"
+
+#include <time.h>
+
+#define ROUNDS 20000
+
+static uint8_t frame[OLED_FB_SIZE];
+static uint8_t out[OLED_FB_WIDTH];
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static void naive_transpose8(const uint8_t in[8], uint8_t result[8]) {
+    for (uint8_t i = 0; i < 8; i++) {
+        result[i] = 0;
+        for (uint8_t j = 0; j < 8; j++) {
+            if (in[j] & (1 << i)) result[i] |= 1 << j;
+        }
+    }
+}
+
+// stránka displeje pro OLED_ORIENT_90 bit po bitu: pixel (x, y) displeje = pixel (y, w - x) snímku
+static void naive_rotate_page(const uint8_t *portrait, uint8_t page, uint8_t *result) {
+    for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) {
+        uint8_t byte = 0;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t px = page * 8 + bit, py = OLED_FB_WIDTH - 1 - x;
+
+            if (portrait[(py / 8) * OLED_ROTATE_PORTRAIT_WIDTH + px] & (1 << (py % 8))) byte |= 1 << bit;
+        }
+        result[x] = byte;
+    }
+}
+
+static volatile uint8_t sink;
+
+int main(void) {
+    uint32_t seed = 1;
+
+    for (uint16_t i = 0; i < OLED_FB_SIZE; i++) {
+        seed     = seed * 1103515245 + 12345;
+        frame[i] = seed >> 16;
+    }
+
+    uint8_t  block[8], rows[8];
+    uint64_t start = now_ns();
+
+    for (uint32_t n = 0; n < ROUNDS * 16; n++) {
+        memcpy(block, frame + (n % 64) * 8, 8);
+        naive_transpose8(block, rows);
+        sink = rows[n & 7];
+    }
+    double naive_block = (double)(now_ns() - start) / (ROUNDS * 16);
+
+    start = now_ns();
+    for (uint32_t n = 0; n < ROUNDS * 16; n++) {
+        memcpy(block, frame + (n % 64) * 8, 8);
+        oled_rotate_transpose8(block, rows);
+        sink = rows[n & 7];
+    }
+    double fast_block = (double)(now_ns() - start) / (ROUNDS * 16);
+
+    start = now_ns();
+    for (uint32_t n = 0; n < ROUNDS; n++) {
+        naive_rotate_page(frame, n % OLED_FB_PAGES, out);
+        sink = out[n & 127];
+    }
+    double naive_page = (double)(now_ns() - start) / ROUNDS;
+
+    start = now_ns();
+    for (uint32_t n = 0; n < ROUNDS; n++) {
+        oled_rotate_page(OLED_ORIENT_90, frame, n % OLED_FB_PAGES, out);
+        sink = out[n & 127];
+    }
+    double fast_page = (double)(now_ns() - start) / ROUNDS;
+
+    uint8_t expected[OLED_FB_WIDTH];
+    naive_rotate_page(frame, 1, expected);
+    oled_rotate_page(OLED_ORIENT_90, frame, 1, out);
+    if (memcmp(expected, out, OLED_FB_WIDTH)) printf("%s: naivní a rychlá stránka se liší, měření neplatí\n", __FILE__);
+
+    printf("%s:                  naivně  transpose8\n", __FILE__);
+    printf("%s: ns/blok 8x8      %6.1f  %10.1f\n", __FILE__, naive_block, fast_block);
+    printf("%s: ns/stránka 90°   %6.1f  %10.1f\n", __FILE__, naive_page, fast_page);
+    return 0;
+}
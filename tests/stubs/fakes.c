@@ -0,0 +1,169 @@
+#include QMK_KEYBOARD_H
+
+#include "host.h"
+#include "key_index.h"
+#include "trace.h"
+#include "timing.h"
+#include "test.h"
+
+int test_failures = 0;
+
+uint32_t         fake_ms = 0;
+fake_log_entry_t fake_log[FAKE_LOG_SIZE];
+uint16_t         fake_log_count = 0;
+
+layer_state_t layer_state = 1;
+
+static void log_action(fake_action_t action, uint16_t code, bool pressed) {
+    if (fake_log_count < FAKE_LOG_SIZE) {
+        fake_log[fake_log_count++] = (fake_log_entry_t){action, code, pressed, fake_ms};
+    }
+}
+
+uint16_t        fake_haptic_pulses = 0;
+haptic_config_t haptic_config      = {.enable = true, .dwell = 20};
+
+#define FAKE_DEFERRED 8
+
+static struct {
+    deferred_token         token; // INVALID_DEFERRED_TOKEN = volné
+    uint32_t               trigger_ms;
+    deferred_exec_callback callback;
+    void                  *cb_arg;
+} deferred[FAKE_DEFERRED];
+static deferred_token next_token = 1;
+
+void fake_reset(void) {
+    fake_ms            = 0;
+    fake_log_count     = 0;
+    fake_haptic_pulses = 0;
+    layer_state        = 1;
+    memset(deferred, 0, sizeof(deferred));
+}
+
+void fake_advance(uint32_t ms) {
+    while (ms--) {
+        fake_ms++;
+        for (uint8_t i = 0; i < FAKE_DEFERRED; i++) {
+            if (deferred[i].token == INVALID_DEFERRED_TOKEN || deferred[i].trigger_ms > fake_ms) continue;
+
+            deferred_token token    = deferred[i].token;
+            uint32_t       interval = deferred[i].callback(deferred[i].trigger_ms, deferred[i].cb_arg);
+
+            if (deferred[i].token != token) continue; // zrušeno z callbacku
+            if (interval) {
+                deferred[i].trigger_ms += interval; // jako QMK: od plánovaného času, ne od zavolání
+            } else {
+                deferred[i].token = INVALID_DEFERRED_TOKEN;
+            }
+        }
+    }
+}
+
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
+    for (uint8_t i = 0; i < FAKE_DEFERRED; i++) {
+        if (deferred[i].token != INVALID_DEFERRED_TOKEN) continue;
+
+        if (next_token == INVALID_DEFERRED_TOKEN) next_token++;
+        deferred[i].token      = next_token++;
+        deferred[i].trigger_ms = fake_ms + delay_ms;
+        deferred[i].callback   = callback;
+        deferred[i].cb_arg     = cb_arg;
+        return deferred[i].token;
+    }
+    return INVALID_DEFERRED_TOKEN;
+}
+
+bool cancel_deferred_exec(deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) return false;
+
+    for (uint8_t i = 0; i < FAKE_DEFERRED; i++) {
+        if (deferred[i].token == token) {
+            deferred[i].token = INVALID_DEFERRED_TOKEN;
+            return true;
+        }
+    }
+    return false;
+}
+
+void haptic_play(void) {
+    fake_haptic_pulses++;
+}
+
+uint8_t haptic_get_dwell(void) {
+    return haptic_config.dwell;
+}
+
+uint16_t timer_read(void) {
+    return fake_ms;
+}
+
+uint32_t timer_read32(void) {
+    return fake_ms;
+}
+
+uint16_t timer_elapsed(uint16_t last) {
+    return (uint16_t)fake_ms - last;
+}
+
+uint32_t timer_elapsed32(uint32_t last) {
+    return fake_ms - last;
+}
+
+uint8_t get_highest_layer(layer_state_t state) {
+    uint8_t layer = 0;
+
+    while (state >>= 1) layer++;
+    return layer;
+}
+
+__attribute__((weak)) layer_state_t layer_state_set_user(layer_state_t state) {
+    return state;
+}
+
+layer_state_t default_layer_state_set_user(layer_state_t state) {
+    return state;
+}
+
+void layer_move(uint8_t layer) {
+    layer_state = layer_state_set_user((layer_state_t)1 << layer);
+}
+
+void layer_on(uint8_t layer) {
+    layer_state = layer_state_set_user(layer_state | (layer_state_t)1 << layer);
+}
+
+void layer_off(uint8_t layer) {
+    layer_state = layer_state_set_user(layer_state & ~((layer_state_t)1 << layer));
+}
+
+void action_exec(keyevent_t event) {
+    log_action(FAKE_EXEC, key_index(event.key), event.pressed);
+}
+
+void register_code16(uint16_t keycode) {
+    log_action(FAKE_REGISTER, keycode, true);
+}
+
+void unregister_code16(uint16_t keycode) {
+    log_action(FAKE_UNREGISTER, keycode, false);
+}
+
+void tap_code16(uint16_t keycode) {
+    log_action(FAKE_TAP, keycode, true);
+}
+
+static host_driver_t *driver = NULL;
+
+void host_set_driver(host_driver_t *next) {
+    driver = next;
+}
+
+host_driver_t *host_get_driver(void) {
+    return driver;
+}
+
+void trace_write(trace_id_t id, uint32_t a, uint32_t b) {} // TRACE_LEVEL = TRACE_OFF, volání jen kvůli linkeru
+
+static timer_hw_t fake_timer;
+timer_hw_t       *timer_hw = &fake_timer;
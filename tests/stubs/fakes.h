@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Stav falešného QMK, který testy nastavují a kontrolují.
+
+extern uint32_t fake_ms; // timer_read32()
+
+typedef enum {
+    FAKE_REGISTER,   // register_code16
+    FAKE_UNREGISTER, // unregister_code16
+    FAKE_TAP,        // tap_code16
+    FAKE_EXEC,       // action_exec, code = index klávesy, pressed podle události
+} fake_action_t;
+
+typedef struct {
+    fake_action_t action;
+    uint16_t      code;
+    bool          pressed;
+    uint32_t      ms; // fake_ms v okamžiku akce
+} fake_log_entry_t;
+
+#define FAKE_LOG_SIZE 256
+
+extern fake_log_entry_t fake_log[FAKE_LOG_SIZE];
+extern uint16_t         fake_log_count;
+
+extern uint16_t fake_haptic_pulses; // haptic_play()
+
+void fake_reset(void);              // čas, vrstvy, deferred exec a záznam akcí na začátek
+void fake_advance(uint32_t ms);     // posune čas po 1 ms a spustí deferred exec, které nastaly
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+
+// časovač RP2040 pro timing.h, testy posouvají timerawl samy (fake_timer v fakes.c)
+typedef struct {
+    volatile uint32_t timerawl;
+} timer_hw_t;
+
+extern timer_hw_t *timer_hw;
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "host_driver.h"
+
+// ovladač nastavuje a čte test, viz fakes.c
+void           host_set_driver(host_driver_t *driver);
+host_driver_t *host_get_driver(void);
@@ -0,0 +1,11 @@
+#pragma once
+
+#include QMK_KEYBOARD_H
+
+typedef struct {
+    uint8_t (*keyboard_leds)(void);
+    void (*send_keyboard)(report_keyboard_t *);
+    void (*send_nkro)(report_nkro_t *);
+    void (*send_mouse)(report_mouse_t *);
+    void (*send_extra)(report_extra_t *);
+} host_driver_t;
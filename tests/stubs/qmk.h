@@ -0,0 +1,205 @@
+#pragma once
+
+// Náhrada QMK_KEYBOARD_H pro testy na hostiteli: jen typy a funkce, které moduly
+// keymapy opravdu používají. Implementace jsou v fakes.c, chování ovládají testy.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h> // dprintf z POSIX, makro níž ho překryje
+
+#include "fakes.h"
+
+#define MATRIX_ROWS 3 // keyboard.json
+#define MATRIX_COLS 4
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define memcpy_P memcpy
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define dprintf(...) ((void)0) // konzole QMK, v testech nic
+
+typedef uint16_t matrix_row_t;
+typedef uint32_t layer_state_t;
+
+#define KC_NO 0x0000
+#define KC_TRNS 0x0001
+#define KC_A 0x0004
+#define KC_B 0x0005
+#define KC_C 0x0006
+#define KC_D 0x0007
+#define KC_E 0x0008
+#define KC_F 0x0009
+#define KC_G 0x000A
+#define KC_H 0x000B
+#define KC_I 0x000C
+#define KC_Z 0x001D
+#define KC_1 0x001E
+#define KC_0 0x0027
+#define KC_ENTER 0x0028
+#define KC_ESCAPE 0x0029
+#define KC_BACKSPACE 0x002A
+#define KC_TAB 0x002B
+#define KC_SPACE 0x002C
+#define KC_MINUS 0x002D
+#define KC_EQUAL 0x002E
+#define KC_CAPS_LOCK 0x0039
+#define KC_F1 0x003A
+#define KC_F12 0x0045
+#define KC_PRINT_SCREEN 0x0046
+#define KC_INSERT 0x0049
+#define KC_HOME 0x004A
+#define KC_PAGE_UP 0x004B
+#define KC_DELETE 0x004C
+#define KC_END 0x004D
+#define KC_PAGE_DOWN 0x004E
+#define KC_RIGHT 0x004F
+#define KC_LEFT 0x0050
+#define KC_DOWN 0x0051
+#define KC_UP 0x0052
+#define KC_F13 0x0068
+#define KC_F24 0x0073
+#define KC_AUDIO_MUTE 0x00A8
+#define KC_AUDIO_VOL_UP 0x00A9
+#define KC_AUDIO_VOL_DOWN 0x00AA
+#define KC_MEDIA_NEXT_TRACK 0x00AB
+#define KC_MEDIA_PREV_TRACK 0x00AC
+#define KC_MEDIA_PLAY_PAUSE 0x00AE
+#define KC_LEFT_CTRL 0x00E0
+#define KC_LEFT_SHIFT 0x00E1
+#define KC_LEFT_ALT 0x00E2
+#define KC_LEFT_GUI 0x00E3
+#define KC_RIGHT_CTRL 0x00E4
+#define KC_RIGHT_SHIFT 0x00E5
+#define KC_RIGHT_ALT 0x00E6
+#define KC_RIGHT_GUI 0x00E7
+#define KC_ENT KC_ENTER
+#define KC_ESC KC_ESCAPE
+#define KC_RGHT KC_RIGHT
+#define KC_MUTE KC_AUDIO_MUTE
+#define KC_VOLU KC_AUDIO_VOL_UP
+#define KC_VOLD KC_AUDIO_VOL_DOWN
+#define KC_MPLY KC_MEDIA_PLAY_PAUSE
+
+#define MOD_LCTL 0x01
+#define MOD_LSFT 0x02
+#define MOD_LALT 0x04
+#define MOD_LGUI 0x08
+#define LCTL(kc) (0x0100 | (kc))
+#define LSFT(kc) (0x0200 | (kc))
+#define IS_QK_MODS(kc) ((kc) >= 0x0100 && (kc) <= 0x1FFF)
+#define QK_MODS_GET_MODS(kc) (((kc) >> 8) & 0x1F)
+#define QK_MODS_GET_BASIC_KEYCODE(kc) ((kc) & 0xFF)
+#define TO(layer) (0x5200 | (layer))
+#define MO(layer) (0x5220 | (layer))
+#define TG(layer) (0x5260 | (layer))
+#define IS_QK_TO(kc) ((kc) >= 0x5200 && (kc) <= 0x521F)
+#define IS_QK_MOMENTARY(kc) ((kc) >= 0x5220 && (kc) <= 0x523F)
+#define IS_QK_TOGGLE_LAYER(kc) ((kc) >= 0x5260 && (kc) <= 0x527F)
+#define QK_TO_GET_LAYER(kc) ((kc) & 0x1F)
+#define QK_MOMENTARY_GET_LAYER(kc) ((kc) & 0x1F)
+#define QK_TOGGLE_LAYER_GET_LAYER(kc) ((kc) & 0x1F)
+#define QK_BOOT 0x7C00
+#define QK_HAPTIC_RESET 0x7C41
+#define QK_HAPTIC_DWELL_UP 0x7C4B
+#define QK_HAPTIC_DWELL_DOWN 0x7C4C
+#define IS_HAPTIC_KEYCODE(kc) ((kc) >= 0x7C40 && (kc) <= 0x7C4C)
+#define QK_USER 0x7E40
+
+// keyboard.json, klávesa 1,3 chybí
+#define LAYOUT_martin_3x3(k00, k01, k02, k03, k10, k11, k12, k20, k21, k22, k23) \
+    {{k00, k01, k02, k03}, {k10, k11, k12, KC_NO}, {k20, k21, k22, k23}}
+
+typedef struct {
+    uint8_t col;
+    uint8_t row;
+} keypos_t;
+
+typedef struct {
+    keypos_t key;
+    uint16_t time;
+    bool     pressed;
+} keyevent_t;
+
+typedef struct {
+    keyevent_t event;
+} keyrecord_t;
+
+#define OLED_DISPLAY_WIDTH 128 // OLED_DISPLAY_128X32, výchozí v QMK
+#define OLED_DISPLAY_HEIGHT 32
+
+// USB reporty (report.h)
+#define KEYBOARD_REPORT_KEYS 6
+#define NKRO_REPORT_BITS 30
+
+typedef struct {
+    uint8_t mods;
+    uint8_t reserved;
+    uint8_t keys[KEYBOARD_REPORT_KEYS];
+} report_keyboard_t;
+
+typedef struct {
+    uint8_t report_id;
+    uint8_t mods;
+    uint8_t bits[NKRO_REPORT_BITS];
+} report_nkro_t;
+
+typedef struct {
+    uint8_t buttons;
+} report_mouse_t;
+
+typedef struct {
+    uint8_t  report_id;
+    uint16_t usage;
+} report_extra_t;
+
+// časovač QMK v ms
+uint16_t timer_read(void);
+uint32_t timer_read32(void);
+uint16_t timer_elapsed(uint16_t last);
+uint32_t timer_elapsed32(uint32_t last);
+
+// vrstvy
+extern layer_state_t layer_state;
+uint8_t get_highest_layer(layer_state_t state);
+void    layer_move(uint8_t layer);
+void    layer_on(uint8_t layer);
+void    layer_off(uint8_t layer);
+layer_state_t default_layer_state_set_user(layer_state_t state);
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key); // dynamická keymapa, implementuje test
+
+// deferred exec, fakes.c ho spouští z fake_advance()
+typedef uint8_t deferred_token;
+typedef uint32_t (*deferred_exec_callback)(uint32_t trigger_time, void *cb_arg);
+#define INVALID_DEFERRED_TOKEN 0
+deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg);
+bool           cancel_deferred_exec(deferred_token token);
+
+// haptika
+typedef union {
+    uint32_t raw;
+    struct {
+        bool    enable : 1;
+        uint8_t mode : 7;
+        uint8_t amplitude : 8;
+        uint8_t dwell : 7;
+    };
+} haptic_config_t;
+extern haptic_config_t haptic_config;
+void    haptic_play(void);
+uint8_t haptic_get_dwell(void);
+
+// akce
+void action_exec(keyevent_t event);
+void register_code16(uint16_t keycode);
+void unregister_code16(uint16_t keycode);
+void tap_code16(uint16_t keycode);
+
+// OLED a aktivita, implementuje je test modulu, který je volá
+uint8_t  oled_get_brightness(void);
+bool     is_oled_on(void);
+void     oled_on(void);
+uint32_t last_input_activity_elapsed(void);
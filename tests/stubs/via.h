@@ -0,0 +1,9 @@
+#pragma once
+
+// čísla příkazů VIA (quantum/via.h), jen ta, na která keymapa reaguje
+enum via_command_id {
+    id_dynamic_keymap_set_keycode = 0x05,
+    id_dynamic_keymap_reset       = 0x06,
+    id_eeprom_reset               = 0x0A,
+    id_dynamic_keymap_set_buffer  = 0x13,
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdio.h>
+
+// Minimální kontroly bez frameworku: chyba se vypíše a test doběhne dál,
+// návratový kód main je počet selhání.
+
+extern int test_failures;
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            fprintf(stderr, "%s:%d: neplatí %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++;                                                   \
+        }                                                                      \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                                                                   \
+    do {                                                                                                                             \
+        long long a_ = (long long)(actual), e_ = (long long)(expected);                                                              \
+        if (a_ != e_) {                                                                                                              \
+            fprintf(stderr, "%s:%d: %s = %lld, čekáno %s = %lld\n", __FILE__, __LINE__, #actual, a_, #expected, e_);                 \
+            test_failures++;                                                                                                         \
+        }                                                                                                                            \
+    } while (0)
+
+#define RUN(test)                  \
+    do {                           \
+        fake_reset();              \
+        test();                    \
+    } while (0)
+
+#define TEST_MAIN_END()                                                     \
+    do {                                                                    \
+        printf("%s: %s\n", __FILE__, test_failures ? "SELHALO" : "ok");     \
+        return test_failures != 0;                                          \
+    } while (0)
@@ -0,0 +1,183 @@
+// chord_engine.c: binární hledání v seřazených maskách, odpálení a pohlcení puštění,
+// tabulky podle vrstvy. Modul se vkládá celý, testy tak vidí i statické funkce.
+
+#include "chord_engine.c"
+#include "test.h"
+
+#define K(i) CHORD_KEY(i)
+
+const chord_t PROGMEM chords[] = { // schválně neseřazené
+    {K(7) | K(8) | K(9), LCTL(KC_Z), CHORD_LAYER(0)},
+    {K(0) | K(1), KC_ESC, CHORD_LAYER(0)},
+    {K(4) | K(5), KC_TAB, CHORD_LAYER(0)},
+    {K(1) | K(2), KC_ENT, CHORD_LAYER(0)},
+    {K(0) | K(2), KC_A, CHORD_LAYER(1)},
+    {K(2) | K(3), KC_B, CHORD_LAYER(0) | CHORD_LAYER(1)},
+    {K(10) | K(6) | K(3), KC_C, CHORD_LAYER(1)},
+};
+const uint16_t chord_count = ARRAY_SIZE(chords);
+
+layer_state_t layer_state_set_user(layer_state_t state) { // jako keymap.c
+    event_publish(EVENT_LAYER_CHANGED, layer_state, state);
+    return state;
+}
+
+static const keypos_t positions[KEY_COUNT] = {
+    {0, 0}, {1, 0}, {2, 0}, {3, 0}, {0, 1}, {1, 1}, {2, 1}, {0, 2}, {1, 2}, {2, 2}, {3, 2},
+};
+
+static bool key(uint8_t index, bool pressed) { // výsledek process_chord, false = pohlceno
+    keyrecord_t record = {.event = {.key = positions[index], .time = fake_ms, .pressed = pressed}};
+
+    return process_chord(KC_NO, &record);
+}
+
+static uint16_t linear_lookup(uint16_t mask, uint8_t layer) {
+    for (uint16_t i = 0; i < chord_count; i++) {
+        if (chords[i].mask == mask && (chords[i].layers & CHORD_LAYER(layer))) return chords[i].keycode;
+    }
+    return KC_NO;
+}
+
+static void test_lookup_matches_linear_search(void) {
+    for (uint8_t layer = 0; layer < 3; layer++) {
+        build(layer);
+
+        for (uint8_t i = 1; i < chord_total; i++) {
+            CHECK(chord_masks[i - 1] < chord_masks[i]);
+        }
+        for (uint16_t mask = 0; mask < MASK_SPACE; mask++) {
+            CHECK_EQ(chord_lookup(mask), linear_lookup(mask, layer));
+        }
+    }
+    CHECK_EQ(chord_total, 0); // vrstva 2 chordy nemá
+    build(0);
+}
+
+static void test_chord_fires_and_swallows_releases(void) {
+    CHECK(!key(0, true));
+    fake_ms += 10;
+    CHECK(!key(1, true)); // A + B, nic delšího nezačíná -> hned odpálí
+    CHECK_EQ(fake_log_count, 1);
+    CHECK_EQ(fake_log[0].action, FAKE_REGISTER);
+    CHECK_EQ(fake_log[0].code, KC_ESC);
+
+    CHECK(!key(0, false));
+    CHECK(!key(1, false));
+    CHECK_EQ(fake_log_count, 2);
+    CHECK_EQ(fake_log[1].action, FAKE_UNREGISTER);
+    CHECK_EQ(fake_log[1].code, KC_ESC);
+}
+
+static void test_held_key_of_previous_chord_stays_swallowed(void) {
+    key(0, true);
+    key(1, true); // ESC
+    key(0, false); // ESC puštěno, B se dál drží
+    key(4, true);
+    key(5, true); // TAB, fired_mask musí pořád obsahovat B
+
+    CHECK(!key(1, false)); // puštění B nesmí propadnout do QMK
+    CHECK(!key(4, false));
+    CHECK(!key(5, false));
+
+    CHECK_EQ(fake_log_count, 4);
+    CHECK_EQ(fake_log[2].code, KC_TAB);
+    CHECK_EQ(fake_log[3].action, FAKE_UNREGISTER);
+    CHECK_EQ(fake_log[3].code, KC_TAB);
+    CHECK_EQ(fired_mask, 0);
+}
+
+static void test_new_chord_releases_previous_keycode(void) {
+    key(0, true);
+    key(1, true); // ESC drženo
+    key(4, true);
+    key(5, true); // TAB nejdřív ukončí ESC
+
+    CHECK_EQ(fake_log_count, 3);
+    CHECK_EQ(fake_log[1].action, FAKE_UNREGISTER);
+    CHECK_EQ(fake_log[1].code, KC_ESC);
+    CHECK_EQ(fake_log[2].code, KC_TAB);
+
+    key(0, false); // klávesy ESC už keycode nedrží, TAB zůstává
+    key(1, false);
+    CHECK_EQ(fake_log_count, 3);
+
+    key(4, false);
+    key(5, false);
+    CHECK_EQ(fake_log_count, 4);
+    CHECK_EQ(fake_log[3].code, KC_TAB);
+}
+
+static void test_non_chord_is_replayed_in_order(void) {
+    key(0, true);
+    fake_ms += 5;
+    CHECK(!key(2, true)); // A + C je chord jen ve vrstvě 1: A se přehraje, C může začínat B + C
+
+    CHECK_EQ(fake_log_count, 1);
+    CHECK_EQ(fake_log[0].action, FAKE_EXEC);
+    CHECK_EQ(fake_log[0].code, 0);
+
+    CHECK(key(0, false));
+    CHECK(key(2, false)); // puštění rozhodne C: stisk se přehraje před puštěním
+    CHECK_EQ(fake_log_count, 2);
+    CHECK_EQ(fake_log[1].code, 2);
+    CHECK(fake_log[1].pressed);
+}
+
+static void test_timeout_replays_single_key(void) {
+    CHECK(!key(7, true)); // G může začínat G + H + I
+    fake_ms += CHORD_TERM - 1;
+    chord_task();
+    CHECK_EQ(fake_log_count, 0);
+
+    fake_ms += 1;
+    chord_task();
+    CHECK_EQ(fake_log_count, 1);
+    CHECK_EQ(fake_log[0].action, FAKE_EXEC);
+    CHECK(key(7, false));
+}
+
+static void test_chords_follow_layer(void) {
+    layer_move(1);
+    key(0, true);
+    key(2, true);
+    CHECK_EQ(fake_log_count, 1);
+    CHECK_EQ(fake_log[0].code, KC_A);
+    key(0, false);
+    key(2, false);
+
+    layer_move(2); // bez chordů: klávesy projdou hned
+    CHECK(key(0, true));
+    CHECK(key(1, true));
+    CHECK(key(0, false));
+    CHECK(key(1, false));
+    CHECK_EQ(fake_log_count, 2);
+
+    layer_move(0);
+}
+
+static void test_layer_change_resolves_buffered_keys(void) {
+    key(7, true);
+    key(8, true); // G + H čeká na I
+    layer_move(2);
+
+    CHECK_EQ(fake_log_count, 2); // rozhodnuto podle vrstvy 0: žádný chord, přehrání
+    CHECK(key(7, false));
+    CHECK(key(8, false));
+    layer_move(0);
+}
+
+int main(void) {
+    chord_init(); // jednou, přihlásí se k EVENT_LAYER_CHANGED
+
+    RUN(test_lookup_matches_linear_search);
+    RUN(test_chord_fires_and_swallows_releases);
+    RUN(test_held_key_of_previous_chord_stays_swallowed);
+    RUN(test_new_chord_releases_previous_keycode);
+    RUN(test_non_chord_is_replayed_in_order);
+    RUN(test_timeout_replays_single_key);
+    RUN(test_chords_follow_layer);
+    RUN(test_layer_change_resolves_buffered_keys);
+
+    TEST_MAIN_END();
+}
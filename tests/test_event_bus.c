@@ -0,0 +1,144 @@
+// event_bus.c: pořadí obsluh, fronta pro události zveřejněné z obsluhy, přetečení
+// fronty a statistika.
+
+#include "event_bus.c"
+#include "test.h"
+
+#define MAX_CALLS 64
+
+typedef struct {
+    char     handler;
+    uint8_t  type;
+    uint32_t value;
+} call_t;
+
+static call_t  calls[MAX_CALLS];
+static uint8_t call_count = 0;
+static uint8_t nested     = 0; // kolik událostí zveřejní handler_nested
+
+static void record(char handler, const event_t *event) {
+    if (call_count < MAX_CALLS) calls[call_count++] = (call_t){handler, event->type, event->new_value};
+}
+
+static void handler_a(const event_t *event) {
+    record('a', event);
+}
+
+static void handler_b(const event_t *event) {
+    record('b', event);
+}
+
+static void handler_nested(const event_t *event) {
+    record('n', event);
+    for (uint8_t i = 0; i < nested; i++) event_publish(EVENT_DESIGN_CHANGED, 0, 100 + i);
+    nested = 0; // jen v první obsluze, vnořené události už nic nezveřejňují
+}
+
+static void reset_bus(void) {
+    subscription_count = 0;
+    queue_head         = 0;
+    queue_count        = 0;
+    dispatching        = false;
+    call_count         = 0;
+    nested             = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+static bool call_is(uint8_t index, char handler, uint8_t type, uint32_t value) {
+    return index < call_count && calls[index].handler == handler && calls[index].type == type && calls[index].value == value;
+}
+
+static void test_subscription_order(void) {
+    reset_bus();
+    CHECK(event_subscribe(EVENT_LAYER_CHANGED, handler_b));
+    CHECK(event_subscribe(EVENT_DESIGN_CHANGED, handler_a));
+    CHECK(event_subscribe(EVENT_LAYER_CHANGED, handler_a));
+
+    event_publish(EVENT_LAYER_CHANGED, 1, 2);
+    CHECK_EQ(call_count, 2);
+    CHECK(call_is(0, 'b', EVENT_LAYER_CHANGED, 2));
+    CHECK(call_is(1, 'a', EVENT_LAYER_CHANGED, 2));
+    CHECK_EQ(stats.published, 1);
+    CHECK_EQ(stats.callbacks, 2);
+    CHECK_EQ(stats.max_queued, 1);
+}
+
+static void test_subscribe_limits(void) {
+    reset_bus();
+    CHECK(!event_subscribe(EVENT_TYPES, handler_a));
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++) CHECK(event_subscribe(EVENT_LAYER_CHANGED, handler_a));
+    CHECK(!event_subscribe(EVENT_LAYER_CHANGED, handler_a));
+    CHECK_EQ(stats.subscribe_failed, 2); // neznámý typ i plná tabulka
+
+    event_publish(EVENT_LAYER_CHANGED, 0, 1);
+    CHECK_EQ(call_count, EVENT_BUS_MAX_SUBSCRIBERS);
+}
+
+static void test_nested_publish_is_fifo(void) {
+    reset_bus();
+    event_subscribe(EVENT_LAYER_CHANGED, handler_nested);
+    event_subscribe(EVENT_LAYER_CHANGED, handler_b);
+    event_subscribe(EVENT_DESIGN_CHANGED, handler_a);
+
+    // vnořené události se doručí až po všech obsluhách té probíhající, v pořadí zveřejnění
+    nested = 3;
+    event_publish(EVENT_LAYER_CHANGED, 0, 1);
+    CHECK_EQ(call_count, 5);
+    CHECK(call_is(0, 'n', EVENT_LAYER_CHANGED, 1));
+    CHECK(call_is(1, 'b', EVENT_LAYER_CHANGED, 1));
+    CHECK(call_is(2, 'a', EVENT_DESIGN_CHANGED, 100));
+    CHECK(call_is(3, 'a', EVENT_DESIGN_CHANGED, 101));
+    CHECK(call_is(4, 'a', EVENT_DESIGN_CHANGED, 102));
+    CHECK_EQ(stats.published, 4);
+    CHECK_EQ(stats.callbacks, 5);
+    CHECK_EQ(stats.max_queued, 3);
+    CHECK_EQ(stats.dropped, 0);
+    CHECK(!dispatching);
+    CHECK_EQ(queue_count, 0);
+}
+
+static void test_queue_overflow_drops_newest(void) {
+    reset_bus();
+    event_subscribe(EVENT_LAYER_CHANGED, handler_nested);
+    event_subscribe(EVENT_DESIGN_CHANGED, handler_a);
+
+    nested = EVENT_BUS_QUEUE_SIZE + 2;
+    event_publish(EVENT_LAYER_CHANGED, 0, 1);
+    CHECK_EQ(stats.dropped, 2);
+    CHECK_EQ(stats.published, 1 + EVENT_BUS_QUEUE_SIZE);
+    CHECK_EQ(stats.max_queued, EVENT_BUS_QUEUE_SIZE);
+    CHECK_EQ(call_count, 1 + EVENT_BUS_QUEUE_SIZE);
+    CHECK(call_is(1, 'a', EVENT_DESIGN_CHANGED, 100));
+    CHECK(call_is(EVENT_BUS_QUEUE_SIZE, 'a', EVENT_DESIGN_CHANGED, 100 + EVENT_BUS_QUEUE_SIZE - 1));
+
+    // fronta se vyprázdnila, další události zase projdou
+    event_publish(EVENT_DESIGN_CHANGED, 0, 7);
+    CHECK(call_is(call_count - 1, 'a', EVENT_DESIGN_CHANGED, 7));
+    CHECK_EQ(stats.dropped, 2);
+}
+
+static void test_rates(void) {
+    reset_bus();
+    event_subscribe(EVENT_LAYER_CHANGED, handler_a);
+    window_start     = timer_read32();
+    window_callbacks = 0;
+    window_ticks     = 0;
+
+    for (uint8_t i = 0; i < 100; i++) {
+        if (i % 10 == 0) event_publish(EVENT_LAYER_CHANGED, 0, i);
+        fake_advance(EVENT_BUS_STATS_WINDOW_MS / 100);
+        event_bus_task();
+    }
+    CHECK_EQ(stats.callbacks_per_second, 10 * 1000 / EVENT_BUS_STATS_WINDOW_MS);
+    CHECK_EQ(stats.ticks_per_second, 100 * 1000 / EVENT_BUS_STATS_WINDOW_MS);
+}
+
+int main(void) {
+    RUN(test_subscription_order);
+    RUN(test_subscribe_limits);
+    RUN(test_nested_publish_is_fifo);
+    RUN(test_queue_overflow_drops_newest);
+    RUN(test_rates);
+
+    TEST_MAIN_END();
+}
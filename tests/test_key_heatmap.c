@@ -0,0 +1,222 @@
+// key_heatmap.c: nasycené čítače, připsání držení vrstvě stisku a střídání záznamů
+// ve dvou sektorech flash včetně přetečení pořadového čísla a nedopsaného záznamu.
+// Flash je pole v RAM se sémantikou NOR: mazání = 0xFF, zápis jen nuluje bity.
+
+#include "key_heatmap.c"
+#include "test.h"
+
+static uint8_t  flash[USER_FLASH_SIZE];
+static uint16_t erases   = 0;
+static uint16_t programs = 0;
+
+void flash_store_erase_sector(uint32_t offset) {
+    memset(flash + offset - USER_FLASH_OFFSET, 0xFF, FLASH_STORE_SECTOR_SIZE);
+    erases++;
+}
+
+void flash_store_program_page(uint32_t offset, const void *data) {
+    const uint8_t *src = data;
+    uint8_t       *dst = flash + offset - USER_FLASH_OFFSET;
+
+    for (uint16_t i = 0; i < FLASH_STORE_PAGE_SIZE; i++) dst[i] &= src[i];
+    programs++;
+}
+
+const void *flash_store_read(uint32_t offset) {
+    return flash + offset - USER_FLASH_OFFSET;
+}
+
+bool event_subscribe(event_type_t type, event_handler_t handler) {
+    return true;
+}
+
+macro_state_t macro_recorder_state(void) {
+    return MACRO_IDLE;
+}
+
+uint32_t last_input_activity_elapsed(void) {
+    return HEATMAP_SAVE_IDLE_MS; // pad se nepoužívá, ukládání smí hned
+}
+
+static void power_cycle(void) { // RAM modulu jako po resetu, flash zůstane
+    memset(&store, 0, sizeof(store));
+    memset(press_layer, 0, sizeof(press_layer));
+    memset(press_time, 0, sizeof(press_time));
+    current_layer = 0;
+    held_keys     = 0;
+    dirty         = false;
+    next_slot     = 0;
+    slot_ready    = false;
+    last_save     = fake_ms;
+    memset(&stats, 0, sizeof(stats));
+    key_heatmap_init();
+}
+
+static void erase_all(void) {
+    memset(flash, 0xFF, sizeof(flash));
+    erases   = 0;
+    programs = 0;
+    power_cycle();
+}
+
+static void key(uint8_t row, uint8_t col, bool pressed) {
+    keyrecord_t record = {.event = {.key = {.col = col, .row = row}, .time = fake_ms, .pressed = pressed}};
+
+    key_heatmap_record(&record);
+}
+
+static void save(void) { // dokončí jedno uložení, i s případným mazáním sektoru
+    uint32_t saves = stats.saves;
+
+    key(0, 0, true);
+    key(0, 0, false);
+    fake_advance(HEATMAP_SAVE_MS);
+    for (uint8_t i = 0; i < 3 && stats.saves == saves; i++) key_heatmap_task();
+    CHECK_EQ(stats.saves, saves + 1);
+}
+
+static void test_presses_saturate(void) {
+    erase_all();
+    store.record.presses[0][0] = UINT16_MAX - 1;
+
+    key(0, 0, true);
+    key(0, 0, false);
+    key(0, 0, true);
+    key(0, 0, false);
+    CHECK_EQ(store.record.presses[0][0], UINT16_MAX);
+}
+
+static void test_hold_saturates(void) {
+    erase_all();
+    store.record.hold_ms[0][1] = UINT32_MAX - 100;
+
+    key(0, 1, true);
+    fake_advance(500);
+    key(0, 1, false);
+    CHECK_EQ(store.record.hold_ms[0][1], UINT32_MAX);
+
+    store.record.hold_ms[0][2] = 1000;
+    key(0, 2, true);
+    fake_advance(250);
+    key(0, 2, false);
+    CHECK_EQ(store.record.hold_ms[0][2], 1250);
+}
+
+static void test_hold_counts_on_press_layer(void) {
+    erase_all();
+
+    key(1, 0, true);
+    current_layer = 2; // změna vrstvy během držení
+    fake_advance(300);
+    key(1, 0, false);
+    CHECK_EQ(store.record.presses[0][4], 1);
+    CHECK_EQ(store.record.hold_ms[0][4], 300);
+    CHECK_EQ(store.record.hold_ms[2][4], 0);
+
+    key(1, 1, false); // puštění bez stisku (např. držené přes reset) se nepočítá
+    CHECK_EQ(store.record.hold_ms[2][5], 0);
+    CHECK_EQ(stats.events, 2);
+}
+
+static void test_slots_rotate_through_both_sectors(void) {
+    erase_all();
+
+    // první uložení smaže sektor 0, dalších SLOTS_PER_SECTOR - 1 do něj jen zapisuje
+    for (uint8_t i = 0; i < SLOTS_PER_SECTOR; i++) save();
+    CHECK_EQ(erases, 1);
+    CHECK_EQ(programs, 2 * SLOTS_PER_SECTOR);
+
+    save(); // přechod do sektoru 1
+    CHECK_EQ(erases, 2);
+
+    for (uint8_t i = 1; i < SLOTS_PER_SECTOR; i++) save();
+    CHECK_EQ(erases, 2);
+    CHECK_EQ(next_slot, 0);
+
+    // návrat do sektoru 0 ho smaže; do zápisu drží poslední stav sektor 1
+    uint16_t presses = store.record.presses[0][0];
+    key(0, 0, true);
+    fake_advance(HEATMAP_SAVE_MS);
+    key_heatmap_task();
+    CHECK_EQ(erases, 3);
+    CHECK_EQ(stats.saves, RECORD_SLOTS);
+
+    power_cycle(); // výpadek mezi mazáním a zápisem
+    CHECK_EQ(store.record.presses[0][0], presses);
+    CHECK_EQ(store.record.seq, RECORD_SLOTS);
+    CHECK_EQ(next_slot, 0);
+    CHECK(!slot_ready); // sektor 0 je sice smazaný, ale modul to po resetu neví a smaže znovu
+}
+
+static void test_sequence_wraps_to_newest(void) {
+    erase_all();
+    store.record.seq = UINT16_MAX - 2;
+
+    for (uint8_t i = 0; i < 5; i++) save(); // seq 0xFFFE, 0xFFFF, 0, 1, 2
+    uint16_t presses = store.record.presses[0][0];
+
+    power_cycle();
+    CHECK_EQ(store.record.seq, 2);
+    CHECK_EQ(store.record.presses[0][0], presses);
+    CHECK_EQ(next_slot, 5);
+    CHECK(slot_ready);
+}
+
+static void test_torn_record_is_rejected(void) {
+    erase_all();
+    for (uint8_t i = 0; i < 3; i++) save();
+
+    uint16_t presses = store.record.presses[0][0];
+
+    // výpadek po první stránce záznamu: novější seq i čítače, ale bez hlavičky
+    key(0, 0, true);
+    store.record.seq++;
+    store.record.magic = HEATMAP_MAGIC;
+    flash_store_program_page(HEATMAP_FLASH_OFFSET + next_slot * RECORD_SIZE, store.pages[0]);
+
+    power_cycle();
+    CHECK_EQ(store.record.seq, 3);
+    CHECK_EQ(store.record.presses[0][0], presses);
+
+    // slot s nedopsaným záznamem není smazaný, zápis do něj by záznam poškodil
+    CHECK_EQ(next_slot, 4);
+    CHECK(slot_ready);
+
+    save();
+    presses = store.record.presses[0][0];
+    power_cycle();
+    CHECK_EQ(store.record.seq, 4);
+    CHECK_EQ(store.record.presses[0][0], presses);
+}
+
+static void test_torn_record_at_sector_end(void) {
+    erase_all();
+    for (uint8_t i = 0; i < SLOTS_PER_SECTOR - 1; i++) save();
+
+    // nedopsaný je poslední slot sektoru, další zápis musí do smazaného sektoru 1
+    store.record.seq++;
+    flash_store_program_page(HEATMAP_FLASH_OFFSET + (SLOTS_PER_SECTOR - 1) * RECORD_SIZE, store.pages[0]);
+
+    power_cycle();
+    CHECK_EQ(store.record.seq, SLOTS_PER_SECTOR - 1);
+    CHECK_EQ(next_slot, SLOTS_PER_SECTOR);
+    CHECK(!slot_ready);
+
+    uint16_t erased = erases;
+    save();
+    CHECK_EQ(erases, erased + 1);
+    power_cycle();
+    CHECK_EQ(store.record.seq, SLOTS_PER_SECTOR);
+}
+
+int main(void) {
+    RUN(test_presses_saturate);
+    RUN(test_hold_saturates);
+    RUN(test_hold_counts_on_press_layer);
+    RUN(test_slots_rotate_through_both_sectors);
+    RUN(test_sequence_wraps_to_newest);
+    RUN(test_torn_record_is_rejected);
+    RUN(test_torn_record_at_sector_end);
+
+    TEST_MAIN_END();
+}
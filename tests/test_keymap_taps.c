@@ -0,0 +1,178 @@
+// keymap.c: vyhodnocení gesta KC_CYCLE_LAYERS (1 tap = další vrstva, 2 = předchozí,
+// 3 = settings vrstva, podržení = settings vrstva jen po dobu držení). Keymapa se
+// vkládá celá, ostatní moduly jsou tu nahrazené prázdnými funkcemi.
+
+#include "keymap.c"
+#include "test.h"
+
+#define TAP_WINDOW 200
+#define HOLD_DELAY 500
+
+user_settings_t user_settings = {.hold_delay_ms = HOLD_DELAY, .tap_window_ms = TAP_WINDOW};
+
+// moduly, které gesto nepoužívá
+void user_settings_init(void) {}
+void user_settings_task(void) {}
+void profile_bank_init(void) {}
+void profile_bank_task(void) {}
+void profile_bank_next(void) {}
+void profile_bank_haptic_save_begin(void) {}
+void profile_bank_haptic_save_end(void) {}
+void chord_init(void) {}
+void chord_task(void) {}
+bool process_chord(uint16_t keycode, keyrecord_t *record) { return true; }
+bool process_turbo_repeat(uint16_t keycode, keyrecord_t *record) { return true; }
+void process_macro_recorder(uint16_t keycode, keyrecord_t *record) {}
+void macro_recorder_task(void) {}
+void macro_recorder_play(bool compressed) {}
+void macro_recorder_toggle_record(void) {}
+void key_heatmap_init(void) {}
+void key_heatmap_task(void) {}
+void key_heatmap_record(keyrecord_t *record) {}
+void report_coalesce_note_event(void) {}
+void report_coalesce_task(void) {}
+void idle_sleep_task(void) {}
+bool boot_stage_reached(boot_stage_t stage) { return true; }
+void boot_stage_task(void) {}
+void usb_suspend_power_down(void) {}
+void usb_suspend_wakeup(void) {}
+void usb_suspend_task(void) {}
+void ram_watch_init(void) {}
+void ram_watch_task(void) {}
+void oled_prefetch_task(void) {}
+void oled_prefetch_mark_input(void) {}
+
+static void reset_gesture(void) {
+    cancel_gesture();
+    previous_base_layer      = 0;
+    last_base_layer          = 0;
+    settings_latched         = false;
+    is_modifier_layer_active = false;
+    last_layer_state         = layer_state;
+}
+
+static void cycle_key(bool pressed) {
+    keyrecord_t record = {.event = {.key = {.row = 0, .col = 3}, .time = fake_ms, .pressed = pressed}};
+
+    CHECK(!process_record_user(KC_CYCLE_LAYERS, &record));
+}
+
+static void tap(void) {
+    cycle_key(true);
+    fake_advance(30);
+    cycle_key(false);
+    fake_advance(30); // další tap ještě v okně TAP_WINDOW
+}
+
+static uint8_t layer(void) {
+    return get_highest_layer(layer_state);
+}
+
+static void test_single_tap_cycles_base_layers(void) {
+    reset_gesture();
+
+    tap();
+    CHECK_EQ(layer(), 0); // čeká se, jestli nepřijde další tap
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), 1);
+
+    tap();
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), 2);
+
+    tap();
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), LAYER_CYCLE_START); // za poslední základní vrstvou zase první
+}
+
+static void test_double_tap_returns_to_previous_layer(void) {
+    reset_gesture();
+
+    tap();
+    fake_advance(TAP_WINDOW); // 0 -> 1
+    tap();
+    fake_advance(TAP_WINDOW); // 1 -> 2
+    CHECK_EQ(layer(), 2);
+
+    tap();
+    tap();
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), 1);
+
+    tap();
+    tap();
+    fake_advance(TAP_WINDOW); // a zpátky, předchozí je teď 2
+    CHECK_EQ(layer(), 2);
+}
+
+static void test_triple_tap_latches_settings_layer(void) {
+    reset_gesture();
+
+    tap();
+    tap();
+    tap();
+    CHECK(layer_state & (1 << 3)); // třetí tap rozhodne hned, bez čekání na okno
+    CHECK(settings_latched);
+
+    fake_advance(TAP_WINDOW * 2);
+    CHECK_EQ(layer(), 3);
+
+    tap(); // další tap settings vrstvu zavře
+    CHECK_EQ(layer(), 0);
+    CHECK(!settings_latched);
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), 0); // zavírací tap nezačal nové gesto
+}
+
+static void test_hold_shows_settings_layer_while_held(void) {
+    reset_gesture();
+
+    cycle_key(true);
+    fake_advance(HOLD_DELAY - 1);
+    CHECK_EQ(layer(), 0);
+    fake_advance(1);
+    CHECK_EQ(layer(), 3);
+
+    fake_advance(1000);
+    cycle_key(false);
+    CHECK_EQ(layer(), 0);
+
+    fake_advance(TAP_WINDOW * 2); // puštění po podržení není tap
+    CHECK_EQ(layer(), 0);
+}
+
+static void test_taps_after_hold_start_a_new_gesture(void) {
+    reset_gesture();
+
+    tap(); // tap a hned podržení: tap se zahodí
+    cycle_key(true);
+    fake_advance(HOLD_DELAY);
+    CHECK_EQ(layer(), 3);
+    cycle_key(false);
+    CHECK_EQ(layer(), 0);
+
+    tap();
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), 1);
+}
+
+static void test_slow_taps_are_separate_gestures(void) {
+    reset_gesture();
+
+    tap();
+    fake_advance(TAP_WINDOW);
+    tap();
+    fake_advance(TAP_WINDOW);
+    CHECK_EQ(layer(), 2); // dva jednoduché tapy, ne dvojitý
+}
+
+int main(void) {
+    RUN(test_single_tap_cycles_base_layers);
+    RUN(test_double_tap_returns_to_previous_layer);
+    RUN(test_triple_tap_latches_settings_layer);
+    RUN(test_hold_shows_settings_layer_while_held);
+    RUN(test_taps_after_hold_start_a_new_gesture);
+    RUN(test_slow_taps_are_separate_gestures);
+
+    TEST_MAIN_END();
+}
@@ -0,0 +1,169 @@
+// oled_anim.c: rozpočet jednoho volání oled_anim_task a doběhnutí všech přechodů
+// do cílového snímku. Odeslání stránky posouvá falešný µs časovač o send_us.
+
+#include "oled_anim.c"
+#include "test.h"
+
+static uint8_t  display[OLED_FB_SIZE]; // co je na displeji
+static uint32_t send_us    = 1500;     // cena odeslání jedné stránky
+static uint16_t pages_sent = 0;
+
+bool oled_i2c_send_page(uint8_t page, const uint8_t *data) {
+    memcpy(display + page * OLED_FB_WIDTH, data, OLED_FB_WIDTH);
+    timer_hw->timerawl += send_us;
+    pages_sent++;
+    return true;
+}
+
+bool is_oled_on(void) {
+    return true;
+}
+
+void oled_on(void) {}
+
+static uint8_t  image_a[OLED_FB_SIZE];
+static uint8_t  image_b[OLED_FB_SIZE];
+static uint32_t seed = 1;
+
+static void fill(uint8_t *image) { // LCG, stejná data v každém běhu
+    for (uint16_t i = 0; i < OLED_FB_SIZE; i++) {
+        seed     = seed * 1103515245 + 12345;
+        image[i] = seed >> 16;
+    }
+}
+
+static void show(const uint8_t *image) { // výchozí snímek bez animace
+    memcpy(oled_fb_back(), image, OLED_FB_SIZE);
+    oled_fb_commit();
+}
+
+// dokončí přechod, vrací počet volání; kontroluje, že žádné volání nepošle víc stránek, než smí
+static uint16_t run_anim(uint8_t max_pages_per_tick) {
+    uint16_t ticks = 0;
+
+    while (oled_anim_active() && ticks < 1000) {
+        uint16_t before = pages_sent;
+
+        oled_anim_task();
+        CHECK(pages_sent - before <= max_pages_per_tick);
+        ticks++;
+    }
+    return ticks;
+}
+
+static void check_kind(oled_anim_kind_t anim) {
+    show(image_a);
+
+    uint32_t commits = oled_fb_stats()->commits;
+
+    oled_anim_start(anim, image_b);
+    CHECK(run_anim(OLED_ANIM_MAX_PAGES) < 1000);
+    CHECK(!oled_anim_active());
+    CHECK_EQ(oled_fb_stats()->commits - commits, OLED_ANIM_FRAMES); // každý snímek přechodu šel na displej
+    CHECK(memcmp(oled_fb_front(), image_b, OLED_FB_SIZE) == 0);
+    CHECK(memcmp(display, image_b, OLED_FB_SIZE) == 0);
+}
+
+static void test_slide_reaches_target(void) {
+    check_kind(OLED_ANIM_SLIDE);
+}
+
+static void test_lift_reaches_target(void) {
+    check_kind(OLED_ANIM_LIFT);
+}
+
+static void test_wipe_reaches_target(void) {
+    check_kind(OLED_ANIM_WIPE);
+}
+
+static bool pixel(const uint8_t *buf, uint8_t x, uint8_t y) { // formát SSD1306
+    return buf[(y / 8) * OLED_FB_WIDTH + x] & (1 << (y % 8));
+}
+
+// pixel snímku OLED_ANIM_FRAMES / 2 spočítaný přímo z popisu přechodu
+static bool half_way_pixel(oled_anim_kind_t anim, uint8_t x, uint8_t y) {
+    const uint8_t half = OLED_DISPLAY_HEIGHT / 2;
+
+    switch (anim) {
+        case OLED_ANIM_SLIDE: // posun o půl šířky doleva
+            return x < OLED_FB_WIDTH / 2 ? pixel(image_a, x + OLED_FB_WIDTH / 2, y) : pixel(image_b, x - OLED_FB_WIDTH / 2, y);
+        case OLED_ANIM_LIFT: // posun o půl výšky nahoru
+            return y < half ? pixel(image_a, x, y + half) : pixel(image_b, x, y - half);
+        default: // horní polovina už nová
+            return y < half ? pixel(image_b, x, y) : pixel(image_a, x, y);
+    }
+}
+
+static void check_half_way(oled_anim_kind_t anim) {
+    show(image_a);
+    oled_anim_start(anim, image_b);
+
+    // složit a odeslat snímky až do poloviny přechodu
+    while (frame <= OLED_ANIM_FRAMES / 2 || oled_fb_busy()) oled_anim_task();
+
+    uint16_t wrong = 0;
+
+    for (uint8_t y = 0; y < OLED_DISPLAY_HEIGHT; y++) {
+        for (uint8_t x = 0; x < OLED_FB_WIDTH; x++) {
+            if (pixel(display, x, y) != half_way_pixel(anim, x, y)) wrong++;
+        }
+    }
+    CHECK_EQ(wrong, 0);
+    run_anim(OLED_ANIM_MAX_PAGES);
+}
+
+static void test_half_way_frames(void) {
+    check_half_way(OLED_ANIM_SLIDE);
+    check_half_way(OLED_ANIM_LIFT);
+    check_half_way(OLED_ANIM_WIPE);
+}
+
+static void test_tick_stays_in_budget(void) {
+    // jakmile je cena stránky změřená, žádné volání rozpočet nepřekročí
+    send_us = OLED_ANIM_BUDGET_US / 2 - 100;
+    show(image_a);
+    oled_anim_start(OLED_ANIM_WIPE, image_b);
+    oled_anim_task();
+
+    uint32_t over = oled_anim_stats()->over_budget;
+
+    run_anim(OLED_ANIM_BUDGET_US / send_us);
+    CHECK_EQ(oled_anim_stats()->over_budget, over);
+    CHECK(oled_anim_stats()->max_tick_us <= OLED_ANIM_BUDGET_US);
+
+    // pomalejší sběrnice: po prvním drahém volání jde jen jedna stránka na volání
+    send_us = OLED_ANIM_BUDGET_US * 3 / 4;
+    show(image_b);
+    oled_anim_start(OLED_ANIM_LIFT, image_a);
+    oled_anim_task();
+    over = oled_anim_stats()->over_budget;
+
+    run_anim(1);
+    CHECK_EQ(oled_anim_stats()->over_budget, over);
+    CHECK(memcmp(display, image_a, OLED_FB_SIZE) == 0);
+    send_us = 1500;
+}
+
+static void test_other_pending_pages_are_not_animation(void) {
+    // stránky rozeslané mimo přechod (např. rovina oled_gray) animaci nezapnou
+    show(image_a);
+    memcpy(oled_fb_back(), image_b, OLED_FB_SIZE);
+    oled_fb_swap();
+    CHECK(oled_fb_busy());
+    CHECK(!oled_anim_active());
+    oled_fb_flush(OLED_FB_PAGES);
+}
+
+int main(void) {
+    fill(image_a);
+    fill(image_b);
+
+    RUN(test_slide_reaches_target);
+    RUN(test_lift_reaches_target);
+    RUN(test_wipe_reaches_target);
+    RUN(test_half_way_frames);
+    RUN(test_tick_stays_in_budget);
+    RUN(test_other_pending_pages_are_not_animation);
+
+    TEST_MAIN_END();
+}
@@ -0,0 +1,142 @@
+// oled_legend.c: snímky legendy všech vrstev proti uloženým stránkám a nové čtení
+// keymapy po zápisu z VIA.
+
+#include "oled_legend.c"
+#include "test.h"
+
+#define LAYERS 5
+
+// vrstvy 0-3 jako v keymap.c, vrstva 4 pokrývá ostatní druhy popisků
+static uint16_t keymap[LAYERS][MATRIX_ROWS][MATRIX_COLS] = {
+    [0] = LAYOUT_martin_3x3(KC_A, KC_B, KC_C, KC_CYCLE_LAYERS, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_TRNS),
+    [1] = LAYOUT_martin_3x3(KC_LEFT, KC_RGHT, KC_MPLY, KC_CYCLE_LAYERS, KC_VOLD, KC_VOLU, KC_MUTE, KC_NO, KC_NO, KC_NO, KC_TRNS),
+    [2] = LAYOUT_martin_3x3(KC_NO, KC_NO, KC_NO, KC_CYCLE_LAYERS, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_NO, KC_TRNS),
+    [3] = LAYOUT_martin_3x3(QK_HAPTIC_RESET, QK_HAPTIC_DWELL_UP, QK_HAPTIC_DWELL_DOWN, KC_CYCLE_LAYERS, KC_DISPLAY_DESIGN, KC_MACRO_REC, KC_MACRO_PLAY, KC_MACRO_PLAY_FAST, KC_PROFILE_NEXT, QK_BOOT, KC_TRNS),
+    [4] = LAYOUT_martin_3x3(KC_1, KC_0, KC_F1 + 9, KC_F13 + 11, LCTL(KC_Z), LSFT(KC_TAB), MO(2), TG(3), TO(1), 0x0099, 0x7123),
+};
+
+uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key) {
+    return keymap[layer][key.row][key.col];
+}
+
+// očekávané popisky po klávesách v pořadí LAYOUT_martin_3x3
+static const char *const labels[LAYERS][KEY_COUNT] = {
+    {"A", "B", "C", "Cyc", "D", "E", "F", "G", "H", "I", "--"},
+    {"Left", "Rght", "Play", "Cyc", "Vol-", "Vol+", "Mute", "", "", "", "--"},
+    {"", "", "", "Cyc", "", "", "", "", "", "", "--"},
+    {"HRst", "Dw+", "Dw-", "Cyc", "Dsgn", "MRec", "MPly", "MFst", "Prof", "Boot", "--"},
+    {"1", "0", "F10", "F24", "^Z", "+Tab", "MO2", "TG3", "TO1", "x99", "7123"},
+};
+
+// FNV-1a jednotlivých stránek snímku, zachycuje i tvar znaků z atlasu oled_text
+static const uint32_t golden[LAYERS][OLED_FB_PAGES] = {
+    {0x0718479F, 0x913702A8, 0xB4D93BD6, 0x5476EE3B},
+    {0x8E8CF50F, 0x6A4CE9EE, 0xB42DA8E2, 0x1B1A4B15},
+    {0x7543B54F, 0x3B722698, 0xA7B537C5, 0x1B1A4B15},
+    {0x94AAC819, 0x6F04115B, 0x2C43D956, 0xA4BB3794},
+    {0x8641F51D, 0xBBC385A7, 0x933F6819, 0xC5383D7F},
+};
+
+static uint32_t fnv1a(const uint8_t *data, uint16_t length) {
+    uint32_t hash = 2166136261u;
+
+    for (uint16_t i = 0; i < length; i++) hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+// snímek složený nezávisle: nadpis a popisky na pozicích podle mřížky z popisu modulu
+static void reference_frame(uint8_t layer, uint8_t *buf) {
+    char title[] = "Layer 0";
+
+    title[6] = '0' + layer;
+    memset(buf, 0, OLED_FB_SIZE);
+    oled_text_draw(buf, 0, 0, title, OLED_TEXT_COLS, true);
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (key_index_map[row][col] < 0) continue;
+            oled_text_draw(buf, row + 1, col * 5 + 1, labels[layer][key_index_map[row][col]], 4, true);
+        }
+    }
+}
+
+static uint8_t frame[OLED_FB_SIZE];
+
+static void test_layer_frames(void) {
+    uint8_t expected[OLED_FB_SIZE];
+
+    for (uint8_t layer = 0; layer < LAYERS; layer++) {
+        memset(frame, 0xAA, sizeof(frame)); // legenda musí buffer nejdřív vymazat
+        CHECK_EQ(oled_legend_draw(frame, layer), KEY_COUNT);
+
+        reference_frame(layer, expected);
+        CHECK(memcmp(frame, expected, OLED_FB_SIZE) == 0);
+
+        for (uint8_t page = 0; page < OLED_FB_PAGES; page++) {
+            uint32_t hash = fnv1a(frame + page * OLED_FB_WIDTH, OLED_FB_WIDTH);
+
+            if (hash != golden[layer][page]) {
+                fprintf(stderr, "vrstva %u stránka %u: 0x%08X, uloženo 0x%08X\n", layer, page, hash, golden[layer][page]);
+                test_failures++;
+            }
+        }
+    }
+}
+
+static void test_same_layer_draws_nothing(void) {
+    oled_legend_draw(frame, 1);
+
+    uint32_t reads = oled_legend_stats()->keymap_reads;
+
+    CHECK_EQ(oled_legend_draw(frame, 1), 0);
+    CHECK_EQ(oled_legend_stats()->keymap_reads, reads); // bez změny se keymapa nečte
+}
+
+static void test_via_edit_redraws_one_cell(void) {
+    uint8_t before[OLED_FB_SIZE];
+
+    oled_legend_draw(frame, 0);
+    memcpy(before, frame, sizeof(frame));
+
+    uint32_t reads = oled_legend_stats()->keymap_reads;
+    uint32_t cells = oled_legend_stats()->cells_drawn;
+    uint32_t edits = oled_legend_stats()->via_edits;
+
+    oled_legend_note_via_command(0x04); // čtení keycodu keymapu nemění
+    CHECK_EQ(oled_legend_draw(frame, 0), 0);
+    CHECK_EQ(oled_legend_stats()->keymap_reads, reads);
+
+    keymap[0][2][1] = KC_ESC; // klávesa 8: "H" -> "Esc"
+    oled_legend_note_via_command(id_dynamic_keymap_set_keycode);
+    CHECK_EQ(oled_legend_stats()->via_edits, edits + 1);
+    CHECK_EQ(oled_legend_draw(frame, 0), 1);
+    CHECK_EQ(oled_legend_stats()->keymap_reads, reads + 1);
+    CHECK_EQ(oled_legend_stats()->cells_drawn, cells + 1);
+
+    // změnily se jen bajty buňky klávesy 8 (stránka 3, znaky 6-9)
+    uint16_t cell_start = 3 * OLED_FB_WIDTH + 6 * OLED_TEXT_GLYPH_WIDTH;
+    uint16_t cell_end   = cell_start + 4 * OLED_TEXT_GLYPH_WIDTH;
+    uint16_t changed    = 0;
+    uint16_t outside    = 0;
+
+    for (uint16_t i = 0; i < OLED_FB_SIZE; i++) {
+        if (frame[i] == before[i]) continue;
+        changed++;
+        if (i < cell_start || i >= cell_end) outside++;
+    }
+    CHECK(changed > 0);
+    CHECK_EQ(outside, 0);
+
+    keymap[0][2][1] = KC_H;
+    oled_legend_note_via_command(id_dynamic_keymap_set_keycode);
+    CHECK_EQ(oled_legend_draw(frame, 0), 1);
+    CHECK(memcmp(frame, before, OLED_FB_SIZE) == 0);
+}
+
+int main(void) {
+    RUN(test_layer_frames);
+    RUN(test_same_layer_draws_nothing);
+    RUN(test_via_edit_redraws_one_cell);
+
+    TEST_MAIN_END();
+}
@@ -0,0 +1,113 @@
+// oled_rotate.c: transpozice 8x8 proti naivní verzi bit po bitu a mapování pixelů
+// všech orientací na celé stránky displeje.
+
+#include "oled_rotate.c"
+#include "test.h"
+
+static uint32_t seed = 1;
+
+static uint8_t random8(void) { // LCG, stejná data v každém běhu
+    seed = seed * 1103515245 + 12345;
+    return seed >> 16;
+}
+
+static void naive_transpose8(const uint8_t in[8], uint8_t out[8]) {
+    for (uint8_t i = 0; i < 8; i++) {
+        out[i] = 0;
+        for (uint8_t j = 0; j < 8; j++) {
+            if (in[j] & (1 << i)) out[i] |= 1 << j;
+        }
+    }
+}
+
+// pixel ve formátu SSD1306: stránka = 8 řádků, bit = řádek ve stránce
+static bool pixel(const uint8_t *buf, uint8_t width, uint8_t x, uint8_t y) {
+    return buf[(y / 8) * width + x] & (1 << (y % 8));
+}
+
+static void render(oled_orient_t orient, const uint8_t *frame, uint8_t *display) {
+    for (uint8_t page = 0; page < OLED_FB_PAGES; page++) {
+        oled_rotate_page(orient, frame, page, display + page * OLED_FB_WIDTH);
+    }
+}
+
+static void random_frame(uint8_t *frame) {
+    for (uint16_t i = 0; i < OLED_FB_SIZE; i++) frame[i] = random8();
+}
+
+static void test_transpose8_matches_naive(void) {
+    // transpose8 jsou jen posuny, AND s konstantou a XOR, tedy lineární zobrazení nad GF(2):
+    // shoda na všech 64 blocích s jedním bitem (báze) znamená shodu na všech 2^64 blocích
+    for (uint8_t bit = 0; bit < 64; bit++) {
+        uint8_t in[8] = {0}, expected[8], out[8];
+
+        in[bit / 8] = 1 << (bit % 8);
+        naive_transpose8(in, expected);
+        oled_rotate_transpose8(in, out);
+        CHECK(memcmp(out, expected, 8) == 0);
+    }
+
+    const uint8_t zero[8] = {0};
+    uint8_t       out[8];
+
+    oled_rotate_transpose8(zero, out); // lineární zobrazení nulu nechá nulou, hlídá i tabulku konstant
+    CHECK(memcmp(out, zero, 8) == 0);
+}
+
+static void test_transpose8_known_blocks(void) {
+    const uint8_t diagonal[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    const uint8_t first[8]    = {0xFF, 0, 0, 0, 0, 0, 0, 0};
+    uint8_t       out[8];
+
+    oled_rotate_transpose8(diagonal, out);
+    CHECK(memcmp(out, diagonal, 8) == 0);
+
+    oled_rotate_transpose8(first, out); // celý první sloupcový bajt = bit 0 všech řádků
+    for (uint8_t i = 0; i < 8; i++) CHECK_EQ(out[i], 0x01);
+}
+
+static void test_landscape_orientations(void) {
+    uint8_t frame[OLED_FB_SIZE], display[OLED_FB_SIZE];
+    uint8_t w = OLED_FB_WIDTH - 1, h = OLED_DISPLAY_HEIGHT - 1;
+
+    random_frame(frame);
+
+    render(OLED_ORIENT_0, frame, display);
+    CHECK(memcmp(display, frame, OLED_FB_SIZE) == 0);
+
+    render(OLED_ORIENT_180, frame, display);
+    for (uint8_t y = 0; y <= h; y++)
+        for (uint8_t x = 0; x <= w; x++) CHECK_EQ(pixel(display, OLED_FB_WIDTH, x, y), pixel(frame, OLED_FB_WIDTH, w - x, h - y));
+
+    render(OLED_ORIENT_MIRROR_X, frame, display);
+    for (uint8_t y = 0; y <= h; y++)
+        for (uint8_t x = 0; x <= w; x++) CHECK_EQ(pixel(display, OLED_FB_WIDTH, x, y), pixel(frame, OLED_FB_WIDTH, w - x, y));
+
+    render(OLED_ORIENT_MIRROR_Y, frame, display);
+    for (uint8_t y = 0; y <= h; y++)
+        for (uint8_t x = 0; x <= w; x++) CHECK_EQ(pixel(display, OLED_FB_WIDTH, x, y), pixel(frame, OLED_FB_WIDTH, x, h - y));
+}
+
+static void test_portrait_rotations(void) {
+    uint8_t frame[OLED_FB_SIZE], display[OLED_FB_SIZE]; // snímek na výšku: 32 x 128
+    uint8_t w = OLED_FB_WIDTH - 1, h = OLED_DISPLAY_HEIGHT - 1;
+
+    random_frame(frame);
+
+    render(OLED_ORIENT_90, frame, display); // doprava: horní okraj snímku je vpravo
+    for (uint8_t y = 0; y <= h; y++)
+        for (uint8_t x = 0; x <= w; x++) CHECK_EQ(pixel(display, OLED_FB_WIDTH, x, y), pixel(frame, OLED_ROTATE_PORTRAIT_WIDTH, y, w - x));
+
+    render(OLED_ORIENT_270, frame, display); // doleva: horní okraj snímku je vlevo
+    for (uint8_t y = 0; y <= h; y++)
+        for (uint8_t x = 0; x <= w; x++) CHECK_EQ(pixel(display, OLED_FB_WIDTH, x, y), pixel(frame, OLED_ROTATE_PORTRAIT_WIDTH, h - y, x));
+}
+
+int main(void) {
+    RUN(test_transpose8_matches_naive);
+    RUN(test_transpose8_known_blocks);
+    RUN(test_landscape_orientations);
+    RUN(test_portrait_rotations);
+
+    TEST_MAIN_END();
+}
@@ -0,0 +1,228 @@
+// oled_saver.c: pořadí a obsah příkazů SSD1306 během ztlumení, posunu, scrollu
+// a probuzení. Sběrnice je nahrazená záznamem transakcí.
+
+#include "oled_saver.c"
+#include "test.h"
+
+#define MAX_SENT 32
+
+static uint8_t  sent[MAX_SENT][16];
+static uint8_t  sent_length[MAX_SENT];
+static uint8_t  sent_count   = 0;
+static uint8_t  bus_failures = 0; // kolik dalších transakcí selže
+static bool     display_on   = true;
+static uint32_t input_ms     = 0; // poslední stisk
+static uint16_t resends      = 0;
+static uint8_t  blanked      = 0;     // bitmapa vymazaných stránek RAM
+static uint8_t  blank_sends  = 0;
+static bool     early_offset = false; // nenulový offset dřív, než byly stránky 4-7 prázdné
+
+static oled_fb_stats_t fb_stats;
+
+bool oled_i2c_send_commands(const uint8_t *commands, uint8_t length) {
+    if (bus_failures) {
+        bus_failures--;
+        return false;
+    }
+    if (commands[0] == SSD1306_SET_DISPLAY_OFFSET && commands[1] != 0 && blanked != 0xF0) early_offset = true;
+    if (sent_count < MAX_SENT) {
+        memcpy(sent[sent_count], commands, length);
+        sent_length[sent_count++] = length;
+    }
+    return true;
+}
+
+bool oled_i2c_send_page(uint8_t page, const uint8_t *data) {
+    if (bus_failures) {
+        bus_failures--;
+        return false;
+    }
+    for (uint8_t i = 0; i < OLED_DISPLAY_WIDTH; i++) {
+        if (data[i] != 0) return true; // nevymazaná stránka se nezapočítá
+    }
+    blanked |= 1 << page;
+    blank_sends++;
+    return true;
+}
+
+void oled_fb_resend(void) {
+    resends++;
+}
+
+const oled_fb_stats_t *oled_fb_stats(void) {
+    return &fb_stats;
+}
+
+uint8_t oled_get_brightness(void) {
+    return 255;
+}
+
+bool is_oled_on(void) {
+    return display_on;
+}
+
+uint32_t last_input_activity_elapsed(void) {
+    return fake_ms - input_ms;
+}
+
+static void reset_saver(void) {
+    stage        = OLED_SAVER_OFF;
+    sent_count   = 0;
+    bus_failures = 0;
+    display_on   = true;
+    input_ms     = 0;
+    resends      = 0;
+    blanked      = 0;
+    blank_sends  = 0;
+    early_offset = false;
+    blank_page   = OLED_FB_PAGES; // jako po startu, RAM za obrazem ještě nikdo nemazal
+    shown_ms     = 0;
+    seen_sent_us = fb_stats.last_sent_us;
+    memset(&stats, 0, sizeof(stats));
+}
+
+static void run_until(uint32_t ms) { // hlavní smyčka po 10 ms
+    while (fake_ms < ms) {
+        fake_advance(10);
+        oled_saver_task();
+    }
+}
+
+static bool sent_is(uint8_t index, const uint8_t *expected, uint8_t length) {
+    return index < sent_count && sent_length[index] == length && memcmp(sent[index], expected, length) == 0;
+}
+
+#define SENT_IS(index, ...) sent_is(index, (const uint8_t[]){__VA_ARGS__}, sizeof((const uint8_t[]){__VA_ARGS__}))
+
+static void test_full_sequence(void) {
+    reset_saver();
+
+    run_until(OLED_SAVER_DIM_MS - 10);
+    CHECK_EQ(sent_count, 0);
+
+    // ztlumení z 255 na OLED_SAVER_CONTRAST v OLED_SAVER_RAMP_STEPS krocích
+    run_until(OLED_SAVER_DIM_MS + OLED_SAVER_RAMP_MS);
+    CHECK_EQ(sent_count, OLED_SAVER_RAMP_STEPS);
+    CHECK(SENT_IS(0, SSD1306_SET_CONTRAST, 226));
+    CHECK(SENT_IS(1, SSD1306_SET_CONTRAST, 196));
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS - 1, SSD1306_SET_CONTRAST, OLED_SAVER_CONTRAST));
+    CHECK_EQ(oled_saver_stage(), OLED_SAVER_ORBIT);
+
+    // posun offsetem jednou za OLED_SAVER_ORBIT_MS, až do scrollu
+    run_until(OLED_SAVER_SCROLL_MS - 10);
+    CHECK_EQ(sent_count, OLED_SAVER_RAMP_STEPS + 4);
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS, SSD1306_SET_DISPLAY_OFFSET, 1));
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS + 1, SSD1306_SET_DISPLAY_OFFSET, 2));
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS + 2, SSD1306_SET_DISPLAY_OFFSET, 1));
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS + 3, SSD1306_SET_DISPLAY_OFFSET, 0));
+    CHECK_EQ(blanked, 0xF0); // stránky 4-7, které offset ukáže
+    CHECK_EQ(blank_sends, 4);
+    CHECK(!early_offset);
+
+    run_until(OLED_SAVER_SCROLL_MS + 120000);
+    CHECK_EQ(sent_count, OLED_SAVER_RAMP_STEPS + 5); // ve scrollu už nic dalšího
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS + 4, SSD1306_SCROLL_RIGHT, 0x00, 0, SSD1306_SCROLL_256_FRAMES, OLED_FB_PAGES - 1, 0x00, 0xFF, SSD1306_SCROLL_ACTIVATE));
+    CHECK_EQ(oled_saver_stage(), OLED_SAVER_SCROLL);
+
+    // probuzení ze scrollu: vypnout scroll, kontrast, offset a poslat celý snímek
+    input_ms = fake_ms;
+    run_until(fake_ms + 10);
+    CHECK_EQ(sent_count, OLED_SAVER_RAMP_STEPS + 6);
+    CHECK(SENT_IS(OLED_SAVER_RAMP_STEPS + 5, SSD1306_SCROLL_DEACTIVATE, SSD1306_SET_CONTRAST, 255, SSD1306_SET_DISPLAY_OFFSET, 0));
+    CHECK_EQ(resends, 1);
+    CHECK_EQ(oled_saver_stage(), OLED_SAVER_OFF);
+
+    uint32_t bytes = 0;
+    for (uint8_t i = 0; i < sent_count; i++) bytes += sent_length[i] + I2C_OVERHEAD;
+    bytes += blank_sends * PAGE_BYTES;
+    CHECK_EQ(oled_saver_stats()->bytes, bytes);
+    CHECK_EQ(oled_saver_stats()->commands, sent_count);
+    CHECK_EQ(oled_saver_stats()->activations, 1);
+    CHECK_EQ(oled_saver_stats()->redraws, 1);
+}
+
+static void test_wake_while_dimming_skips_scroll_and_redraw(void) {
+    reset_saver();
+
+    run_until(OLED_SAVER_DIM_MS + OLED_SAVER_RAMP_MS / 2);
+    uint8_t steps = sent_count;
+    CHECK(steps > 0 && steps < OLED_SAVER_RAMP_STEPS);
+
+    input_ms = fake_ms;
+    run_until(fake_ms + 10);
+    CHECK_EQ(sent_count, steps + 1);
+    CHECK(SENT_IS(steps, SSD1306_SET_CONTRAST, 255, SSD1306_SET_DISPLAY_OFFSET, 0));
+    CHECK_EQ(resends, 0);
+}
+
+static void test_spare_pages_blanked_once_per_scroll(void) {
+    reset_saver();
+
+    run_until(OLED_SAVER_DIM_MS + OLED_SAVER_RAMP_MS + OLED_SAVER_ORBIT_MS + 100);
+    CHECK_EQ(blank_sends, 4);
+
+    // probuzení bez scrollu: RAM za obrazem zůstala prázdná
+    input_ms = fake_ms;
+    run_until(fake_ms + 10);
+    run_until(fake_ms + OLED_SAVER_DIM_MS + OLED_SAVER_RAMP_MS + OLED_SAVER_ORBIT_MS + 100);
+    CHECK_EQ(oled_saver_stage(), OLED_SAVER_ORBIT);
+    CHECK_EQ(blank_sends, 4);
+
+    // scroll RAM zneplatní, další posun ji maže znovu
+    run_until(input_ms + OLED_SAVER_SCROLL_MS + 100);
+    CHECK_EQ(oled_saver_stage(), OLED_SAVER_SCROLL);
+    input_ms = fake_ms;
+    run_until(fake_ms + 10);
+    blanked      = 0;
+    early_offset = false;
+    run_until(fake_ms + OLED_SAVER_DIM_MS + OLED_SAVER_RAMP_MS + OLED_SAVER_ORBIT_MS + 100);
+    CHECK_EQ(blank_sends, 8);
+    CHECK_EQ(blanked, 0xF0);
+    CHECK(!early_offset);
+}
+
+static void test_new_frame_counts_as_activity(void) {
+    reset_saver();
+
+    run_until(OLED_SAVER_DIM_MS / 2);
+    fb_stats.last_sent_us += 1000; // displej dostal nový obsah
+    run_until(OLED_SAVER_DIM_MS + 100);
+    CHECK_EQ(sent_count, 0);
+
+    run_until(OLED_SAVER_DIM_MS * 3 / 2 + 10);
+    CHECK_EQ(sent_count, 1);
+}
+
+static void test_display_off_sends_nothing(void) {
+    reset_saver();
+    display_on = false;
+
+    run_until(OLED_SAVER_SCROLL_MS + 1000);
+    CHECK_EQ(sent_count, 0);
+    CHECK_EQ(oled_saver_stage(), OLED_SAVER_OFF);
+}
+
+static void test_failed_transfer_is_retried(void) {
+    reset_saver();
+
+    run_until(OLED_SAVER_DIM_MS - 10);
+    bus_failures = 2;
+    run_until(OLED_SAVER_DIM_MS + 20); // dvě selhání, třetí pokus projde
+    CHECK_EQ(sent_count, 1);
+    CHECK(SENT_IS(0, SSD1306_SET_CONTRAST, 226));
+    CHECK_EQ(oled_saver_stats()->commands, 1);
+
+    run_until(OLED_SAVER_DIM_MS + OLED_SAVER_RAMP_MS + 20);
+    CHECK_EQ(sent_count, OLED_SAVER_RAMP_STEPS); // žádný krok se nepřeskočil
+}
+
+int main(void) {
+    RUN(test_full_sequence);
+    RUN(test_wake_while_dimming_skips_scroll_and_redraw);
+    RUN(test_spare_pages_blanked_once_per_scroll);
+    RUN(test_new_frame_counts_as_activity);
+    RUN(test_display_off_sends_nothing);
+    RUN(test_failed_transfer_is_retried);
+
+    TEST_MAIN_END();
+}
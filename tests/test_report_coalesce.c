@@ -0,0 +1,223 @@
+// report_coalesce.c: slučování reportů jednoho scanu nesmí ztratit stisk ani puštění,
+// modifikátory se posuzují stejně jako klávesy a během probouzení jde všechno do
+// fronty, nikdy do USB. Původní ovladač nahrazuje záznam reportů.
+
+#include "report_coalesce.c"
+#include "test.h"
+
+#define MAX_SENT 32
+
+typedef enum { SENT_KEYBOARD, SENT_NKRO, SENT_EXTRA } sent_kind_t;
+
+static struct {
+    sent_kind_t       kind;
+    report_keyboard_t keyboard;
+    report_nkro_t     nkro;
+} sent[MAX_SENT];
+static uint8_t sent_count = 0;
+
+static void usb_send_keyboard(report_keyboard_t *report) {
+    if (sent_count < MAX_SENT) sent[sent_count++] = (typeof(sent[0])){.kind = SENT_KEYBOARD, .keyboard = *report};
+}
+
+static void usb_send_nkro(report_nkro_t *report) {
+    if (sent_count < MAX_SENT) sent[sent_count++] = (typeof(sent[0])){.kind = SENT_NKRO, .nkro = *report};
+}
+
+static void usb_send_mouse(report_mouse_t *report) {}
+
+static void usb_send_extra(report_extra_t *report) {
+    if (sent_count < MAX_SENT) sent[sent_count++] = (typeof(sent[0])){.kind = SENT_EXTRA};
+}
+
+static host_driver_t usb = {NULL, usb_send_keyboard, usb_send_nkro, usb_send_mouse, usb_send_extra};
+
+static void reset_coalesce(void) {
+    host_set_driver(&usb);
+    usb_driver       = NULL;
+    keyboard_pending = false;
+    nkro_pending     = false;
+    held             = false;
+    queued           = 0;
+    sent_count       = 0;
+    memset(&sent_keyboard, 0, sizeof(sent_keyboard));
+    memset(&sent_nkro, 0, sizeof(sent_nkro));
+    memset(&stats, 0, sizeof(stats));
+    report_coalesce_task(); // nainstaluje se místo usb
+}
+
+// klávesy jako v QMK: 6KRO pole keys, modifikátory zvlášť
+static void keyboard(uint8_t mods, uint8_t key1, uint8_t key2) {
+    report_keyboard_t report = {.mods = mods, .keys = {key1, key2}};
+
+    host_get_driver()->send_keyboard(&report);
+}
+
+static void nkro(uint8_t mods, uint8_t key) {
+    report_nkro_t report = {.mods = mods};
+
+    if (key) report.bits[key >> 3] |= 1 << (key & 7);
+    host_get_driver()->send_nkro(&report);
+}
+
+static bool sent_is(uint8_t index, uint8_t mods, uint8_t key1, uint8_t key2) {
+    if (index >= sent_count || sent[index].kind != SENT_KEYBOARD) return false;
+
+    const report_keyboard_t *report = &sent[index].keyboard;
+    return report->mods == mods && report->keys[0] == key1 && report->keys[1] == key2;
+}
+
+static bool nkro_has(uint8_t index, uint8_t key) {
+    return index < sent_count && sent[index].kind == SENT_NKRO && (sent[index].nkro.bits[key >> 3] & (1 << (key & 7)));
+}
+
+static void test_driver_is_wrapped(void) {
+    reset_coalesce();
+    CHECK(host_get_driver() != &usb);
+    CHECK(usb_driver == &usb);
+}
+
+static void test_presses_in_one_scan_merge(void) {
+    reset_coalesce();
+
+    keyboard(0, KC_A, 0);
+    keyboard(0, KC_A, KC_B);
+    CHECK_EQ(sent_count, 0); // čeká na konec průchodu smyčkou
+    report_coalesce_task();
+
+    CHECK_EQ(sent_count, 1);
+    CHECK(sent_is(0, 0, KC_A, KC_B));
+    CHECK_EQ(stats.reports_merged, 1);
+}
+
+static void test_tap_within_window_is_kept(void) {
+    reset_coalesce();
+
+    keyboard(0, KC_A, 0); // stisk a puštění ve stejném scanu (tap_code)
+    keyboard(0, 0, 0);
+    CHECK_EQ(sent_count, 1); // stisk odešel hned, jinak by ho puštění přepsalo
+    report_coalesce_task();
+
+    CHECK_EQ(sent_count, 2);
+    CHECK(sent_is(0, 0, KC_A, 0));
+    CHECK(sent_is(1, 0, 0, 0));
+    CHECK_EQ(stats.reports_merged, 0);
+}
+
+static void test_release_and_other_press_merge(void) {
+    reset_coalesce();
+    keyboard(0, KC_A, 0);
+    report_coalesce_task();
+
+    keyboard(0, 0, 0); // puštění A a stisk B: obě změny přežijí ve výsledném reportu
+    keyboard(0, KC_B, 0);
+    report_coalesce_task();
+
+    CHECK_EQ(sent_count, 2);
+    CHECK(sent_is(1, 0, KC_B, 0));
+}
+
+static void test_modifier_changes(void) {
+    reset_coalesce();
+
+    keyboard(MOD_LCTL, 0, 0); // Ctrl a pak Ctrl+Z: jeden report
+    keyboard(MOD_LCTL, KC_Z, 0);
+    report_coalesce_task();
+    CHECK_EQ(sent_count, 1);
+    CHECK(sent_is(0, MOD_LCTL, KC_Z, 0));
+
+    keyboard(MOD_LCTL | MOD_LSFT, KC_Z, 0); // Shift ťuknutý ve stejném scanu
+    keyboard(MOD_LCTL, KC_Z, 0);
+    report_coalesce_task();
+    CHECK_EQ(sent_count, 3);
+    CHECK(sent_is(1, MOD_LCTL | MOD_LSFT, KC_Z, 0));
+    CHECK(sent_is(2, MOD_LCTL, KC_Z, 0));
+
+    keyboard(MOD_LCTL, 0, 0); // puštění Z, pak Ctrl: obě změny v posledním reportu
+    keyboard(0, 0, 0);
+    report_coalesce_task();
+    CHECK_EQ(sent_count, 4);
+    CHECK(sent_is(3, 0, 0, 0));
+}
+
+static void test_nkro_tap_is_kept(void) {
+    reset_coalesce();
+
+    nkro(0, KC_F);
+    nkro(0, 0);
+    report_coalesce_task();
+
+    CHECK_EQ(sent_count, 2);
+    CHECK(nkro_has(0, KC_F));
+    CHECK(!nkro_has(1, KC_F));
+}
+
+static void test_extra_does_not_overtake(void) {
+    reset_coalesce();
+
+    keyboard(0, KC_A, 0);
+    host_get_driver()->send_extra(&(report_extra_t){0});
+    CHECK_EQ(sent_count, 2);
+    CHECK(sent_is(0, 0, KC_A, 0));
+    CHECK_EQ(sent[1].kind, SENT_EXTRA);
+}
+
+static void test_hold_queues_in_order(void) {
+    reset_coalesce();
+    report_coalesce_hold(true);
+
+    keyboard(0, KC_A, 0); // tap A, tap B, stisk C
+    keyboard(0, 0, 0);
+    keyboard(0, KC_B, 0);
+    keyboard(0, 0, 0);
+    keyboard(0, KC_C, 0);
+    report_coalesce_task();
+    CHECK_EQ(sent_count, 0);
+
+    report_coalesce_hold(false);
+    CHECK_EQ(sent_count, 2); // A a B z fronty, čekající C až s dalším průchodem
+    CHECK(sent_is(0, 0, KC_A, 0));
+    CHECK(sent_is(1, 0, KC_B, 0));
+
+    report_coalesce_task();
+    CHECK_EQ(sent_count, 3);
+    CHECK(sent_is(2, 0, KC_C, 0));
+    CHECK_EQ(stats.reports_dropped, 0);
+}
+
+static void test_full_queue_never_reaches_usb(void) {
+    reset_coalesce();
+    report_coalesce_hold(true);
+
+    const uint8_t taps = REPORT_QUEUE_SIZE + 2;
+
+    for (uint8_t i = 0; i < taps; i++) {
+        keyboard(0, KC_A + i, 0);
+        keyboard(0, 0, 0);
+    }
+    report_coalesce_task();
+    CHECK_EQ(sent_count, 0); // hostitel ještě neposlouchá
+    CHECK_EQ(stats.reports_dropped, taps - REPORT_QUEUE_SIZE);
+
+    report_coalesce_hold(false);
+    report_coalesce_task();
+
+    // nejstarší taps vypadly, zbytek v původním pořadí, poslední stav platí
+    CHECK_EQ(sent_count, REPORT_QUEUE_SIZE + 1);
+    for (uint8_t i = 0; i < REPORT_QUEUE_SIZE; i++) CHECK(sent_is(i, 0, KC_A + taps - REPORT_QUEUE_SIZE + i, 0));
+    CHECK(sent_is(REPORT_QUEUE_SIZE, 0, 0, 0));
+}
+
+int main(void) {
+    RUN(test_driver_is_wrapped);
+    RUN(test_presses_in_one_scan_merge);
+    RUN(test_tap_within_window_is_kept);
+    RUN(test_release_and_other_press_merge);
+    RUN(test_modifier_changes);
+    RUN(test_nkro_tap_is_kept);
+    RUN(test_extra_does_not_overtake);
+    RUN(test_hold_queues_in_order);
+    RUN(test_full_queue_never_reaches_usb);
+
+    TEST_MAIN_END();
+}
@@ -0,0 +1,128 @@
+// turbo_repeat.c: interval lineárně zrychlujícího opakování a časy tapů z deferred exec.
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "turbo_repeat.c"
+#include "test.h"
+
+const turbo_profile_t PROGMEM turbo_profiles[] = {
+    {KC_A, 300, 10, 40, 1000}, // 10 -> 40 Hz za sekundu
+    {KC_B, 200, 25, 25, 0},    // stálá frekvence, bez rampy
+};
+const uint8_t turbo_profile_count = ARRAY_SIZE(turbo_profiles);
+
+static uint16_t reference_interval(const turbo_profile_t *profile, uint32_t elapsed) { // v plovoucí čárce
+    double ramp = profile->ramp_ms ? profile->ramp_ms : 1;
+    double t    = elapsed < ramp ? elapsed : ramp;
+    double hz   = profile->start_hz + (profile->max_hz - profile->start_hz) * t / ramp;
+
+    return hz > 0 ? (uint16_t)lround(1000 / hz) : 1000;
+}
+
+static bool key(uint16_t keycode, uint8_t col, bool pressed) {
+    keyrecord_t record = {.event = {.key = {.row = 0, .col = col}, .time = fake_ms, .pressed = pressed}};
+
+    return process_turbo_repeat(keycode, &record);
+}
+
+static void test_interval_endpoints(void) {
+    const turbo_profile_t *ramp = &turbo_profiles[0];
+
+    CHECK_EQ(turbo_repeat_interval(ramp, 0), 100);     // 10 Hz
+    CHECK_EQ(turbo_repeat_interval(ramp, 500), 40);    // 25 Hz
+    CHECK_EQ(turbo_repeat_interval(ramp, 1000), 25);   // 40 Hz
+    CHECK_EQ(turbo_repeat_interval(ramp, 100000), 25); // po rampě se nezrychluje dál
+    CHECK_EQ(turbo_repeat_interval(&turbo_profiles[1], 0), 40);
+}
+
+static void test_interval_matches_reference_and_decreases(void) {
+    const turbo_profile_t profiles[] = {
+        {KC_A, 0, 10, 40, 1000},
+        {KC_A, 0, 1, 255, 3000},
+        {KC_A, 0, 60, 7, 700}, // zpomalování
+        {KC_A, 0, 33, 34, 65535},
+    };
+
+    for (uint8_t p = 0; p < ARRAY_SIZE(profiles); p++) {
+        uint16_t previous = turbo_repeat_interval(&profiles[p], 0);
+
+        for (uint32_t t = 0; t <= profiles[p].ramp_ms + 100u; t += 7) {
+            uint16_t interval  = turbo_repeat_interval(&profiles[p], t);
+            int      reference = reference_interval(&profiles[p], t);
+
+            CHECK(abs(interval - reference) <= 1); // zaokrouhlení celočíselného dělení
+            if (profiles[p].max_hz >= profiles[p].start_hz) {
+                CHECK(interval <= previous);
+            } else {
+                CHECK(interval >= previous);
+            }
+            previous = interval;
+        }
+    }
+}
+
+static void test_interval_edge_profiles(void) {
+    const turbo_profile_t zero = {KC_A, 0, 0, 0, 100};
+    const turbo_profile_t fast = {KC_A, 0, 255, 255, 0};
+
+    CHECK_EQ(turbo_repeat_interval(&zero, 50), 1000); // nulová frekvence nedělí nulou
+    CHECK_EQ(turbo_repeat_interval(&fast, 0), 4);
+    CHECK(turbo_repeat_interval(&fast, 0) >= 1);
+}
+
+static void test_taps_follow_schedule(void) {
+    const turbo_profile_t *profile = &turbo_profiles[0];
+
+    CHECK(!key(KC_A, 0, true));
+    CHECK_EQ(fake_log_count, 1); // první tap hned při stisku
+    CHECK_EQ(fake_log[0].ms, 0);
+
+    fake_advance(2000);
+    CHECK(!key(KC_A, 0, false));
+    uint16_t taps = fake_log_count;
+    fake_advance(500);
+    CHECK_EQ(fake_log_count, taps); // po puštění už nic
+
+    uint32_t expected = profile->delay_ms; // první opakování po delay_ms, pak podle rampy
+    for (uint16_t i = 1; i < taps; i++) {
+        CHECK_EQ(fake_log[i].action, FAKE_TAP);
+        CHECK_EQ(fake_log[i].code, KC_A);
+        CHECK_EQ(fake_log[i].ms, expected);
+        expected += turbo_repeat_interval(profile, expected - profile->delay_ms);
+    }
+    CHECK(taps > 40);
+    CHECK_EQ(turbo_repeat_stats()->last_interval_ms, 25);
+}
+
+static void test_key_without_profile_passes_through(void) {
+    CHECK(key(KC_C, 1, true));
+    fake_advance(1000);
+    CHECK(key(KC_C, 1, false));
+    CHECK_EQ(fake_log_count, 0);
+}
+
+static void test_release_matches_position(void) {
+    key(KC_B, 2, true);
+    key(KC_A, 3, true);
+    fake_advance(250);
+    CHECK(!key(KC_A, 3, false)); // pouští se podle pozice, ne podle keycode
+
+    uint16_t taps = fake_log_count;
+    fake_advance(400);
+    CHECK(fake_log_count > taps); // B dál opakuje
+    for (uint16_t i = taps; i < fake_log_count; i++) CHECK_EQ(fake_log[i].code, KC_B);
+
+    CHECK(!key(KC_B, 2, false));
+}
+
+int main(void) {
+    RUN(test_interval_endpoints);
+    RUN(test_interval_matches_reference_and_decreases);
+    RUN(test_interval_edge_profiles);
+    RUN(test_taps_follow_schedule);
+    RUN(test_key_without_profile_passes_through);
+    RUN(test_release_matches_position);
+
+    TEST_MAIN_END();
+}
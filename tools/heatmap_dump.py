@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""Výpis čítačů kláves z macropadu přes raw HID (příkaz 0x41).
+
+    heatmap_dump.py            stisky a doba držení pro všechny 4 vrstvy
+    heatmap_dump.py reset      vynuluje čítače
+    heatmap_dump.py benchmark  náklad započítání jedné události na desce
+"""
+
+import struct
+import sys
+
+from layer_switch import REPORT_SIZE, open_device
+
+RAW_HID_HEATMAP = 0x41
+READ_PRESSES, READ_HOLD, RESET, BENCHMARK = range(4)
+LAYERS = 4
+KEYS = 11
+BENCHMARK_EVENTS = 1000
+
+
+def command(device, op, layer=0, first=0):
+    device.write(b"\0" + bytes([RAW_HID_HEATMAP, op, layer, first]).ljust(REPORT_SIZE, b"\0"))
+    while True:
+        reply = bytes(device.read(REPORT_SIZE, 1000))
+        if not reply:
+            raise TimeoutError("bez odpovědi")
+        if reply[0] == RAW_HID_HEATMAP and reply[1] == op:
+            if reply[2] != 0:
+                raise ValueError("neplatný podpříkaz, vrstva nebo klávesa")
+            return reply[5:]
+
+
+def main():
+    device = open_device()
+    try:
+        if sys.argv[1:] == ["reset"]:
+            command(device, RESET)
+            print("čítače vynulované")
+        elif sys.argv[1:] == ["benchmark"]:
+            (spent_us,) = struct.unpack_from("<I", command(device, BENCHMARK))
+            print("%d us / %d událostí = %.0f ns na událost" % (spent_us, BENCHMARK_EVENTS, spent_us * 1000 / BENCHMARK_EVENTS))
+        else:
+            for layer in range(LAYERS):
+                presses = struct.unpack_from("<%dH" % KEYS, command(device, READ_PRESSES, layer))
+                hold = struct.unpack_from("<6I", command(device, READ_HOLD, layer, 0))
+                hold += struct.unpack_from("<5I", command(device, READ_HOLD, layer, 6))
+                print("vrstva %d" % layer)
+                for key in range(KEYS):
+                    print("  klávesa %2d: %6d stisků, drženo %8.1f s" % (key, presses[key], hold[key] / 1000))
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Přepínání vrstvy a designu displeje macropadu přes raw HID (příkaz 0x40).
+
+    layer_switch.py set 1 [design]     přepne vrstvu (a design), vypíše odpověď
+    layer_switch.py daemon map.txt     zástupce démona: čte názvy aplikací ze stdin
+    layer_switch.py loopback [počet]   měří dobu odezvy přepnutí (příkaz -> potvrzení)
+
+map.txt obsahuje řádky "aplikace vrstva [design]", např. "gimp 1 2".
+Potřebuje balík hidapi (pip install hidapi).
+"""
+
+import statistics
+import struct
+import sys
+import time
+
+import hid
+
+VID = 0x4D16
+PID = 0x0002
+USAGE_PAGE = 0xFF60  # raw HID rozhraní VIA
+USAGE = 0x61
+REPORT_SIZE = 32
+
+RAW_HID_SET_LAYER = 0x40
+RAW_HID_KEEP = 0xFF
+STATUS = {0: "ok", 1: "invalid"}
+
+
+def open_device():
+    for info in hid.enumerate(VID, PID):
+        if info["usage_page"] == USAGE_PAGE and info["usage"] == USAGE:
+            device = hid.device()
+            device.open_path(info["path"])
+            return device
+    sys.exit("macropad nenalezen (VID %04X PID %04X)" % (VID, PID))
+
+
+def set_layer(device, layer, design=RAW_HID_KEEP, timeout_ms=1000):
+    """Vrací (stav, vrstva, design, µs zpracování na desce)."""
+    report = bytes([RAW_HID_SET_LAYER, layer, design]).ljust(REPORT_SIZE, b"\0")
+    device.write(b"\0" + report)  # první bajt = report ID
+
+    while True:
+        reply = bytes(device.read(REPORT_SIZE, timeout_ms))
+        if not reply:
+            raise TimeoutError("bez odpovědi")
+        if reply[0] == RAW_HID_SET_LAYER:
+            status, layer, design = reply[1], reply[2], reply[3]
+            (spent_us,) = struct.unpack_from("<I", reply, 4)
+            return status, layer, design, spent_us
+
+
+def cmd_set(device, args):
+    layer = int(args[0])
+    design = int(args[1]) if len(args) > 1 else RAW_HID_KEEP
+    status, layer, design, spent_us = set_layer(device, layer, design)
+    print("%s: vrstva %d, design %d (%d us na desce)" % (STATUS.get(status, status), layer, design, spent_us))
+
+
+def cmd_daemon(device, args):
+    mapping = {}
+    with open(args[0], encoding="utf-8") as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) >= 2 and not parts[0].startswith("#"):
+                design = int(parts[2]) if len(parts) > 2 else RAW_HID_KEEP
+                mapping[parts[0].lower()] = (int(parts[1]), design)
+
+    current = None
+    for line in sys.stdin:  # skutečný démon by sledoval aktivní okno, tady stačí jeho název na řádku
+        app = line.strip().lower()
+        target = mapping.get(app)
+        if target is None or target == current:
+            continue
+        start = time.perf_counter()
+        status = set_layer(device, *target)[0]
+        print("%s -> vrstva %d: %s, %.2f ms" % (app, target[0], STATUS.get(status, status), (time.perf_counter() - start) * 1000))
+        current = target
+
+
+def cmd_loopback(device, args):
+    count = int(args[0]) if args else 200
+    rtt = []
+    board = []
+    for i in range(count):
+        start = time.perf_counter()
+        status, _, _, spent_us = set_layer(device, i % 2)
+        rtt.append((time.perf_counter() - start) * 1000)
+        board.append(spent_us)
+        if status != 0:
+            sys.exit("deska odmítla příkaz")
+    set_layer(device, 0)
+
+    rtt.sort()
+    print("přepnutí: %d" % count)
+    print("odezva ms: min %.2f  medián %.2f  p99 %.2f  max %.2f"
+          % (rtt[0], statistics.median(rtt), rtt[int(len(rtt) * 0.99) - 1], rtt[-1]))
+    print("zpracování na desce us: medián %d  max %d" % (statistics.median(board), max(board)))
+
+
+def main():
+    if len(sys.argv) < 2 or sys.argv[1] not in ("set", "daemon", "loopback"):
+        sys.exit(__doc__)
+    device = open_device()
+    try:
+        {"set": cmd_set, "daemon": cmd_daemon, "loopback": cmd_loopback}[sys.argv[1]](device, sys.argv[2:])
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()
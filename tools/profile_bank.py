@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""Profily keymapy v bankách flash přes raw HID (příkaz 0x43).
+
+    profile_bank.py             aktivní profil a obsazené banky
+    profile_bank.py select N    přepne na profil N (0 = keymapa VIA)
+    profile_bank.py store N     uloží aktuální keymapu VIA, design a haptiku do banky N (1..),
+                                zápis do flash proběhne, až se na padu chvíli nepíše
+"""
+
+import struct
+import sys
+import time
+
+from layer_switch import REPORT_SIZE, open_device
+
+RAW_HID_PROFILE = 0x43
+SELECT, STORE, INFO = range(3)
+
+
+def command(device, op, profile=0):
+    device.write(b"\0" + bytes([RAW_HID_PROFILE, op, profile]).ljust(REPORT_SIZE, b"\0"))
+    while True:
+        reply = bytes(device.read(REPORT_SIZE, 2000))
+        if not reply:
+            raise TimeoutError("bez odpovědi")
+        if reply[0] == RAW_HID_PROFILE:
+            if reply[2] != 0:
+                raise ValueError("neplatný nebo prázdný profil")
+            return reply[3], reply[4:]
+
+
+def main():
+    device = open_device()
+    try:
+        if len(sys.argv) == 3 and sys.argv[1] == "select":
+            active, data = command(device, SELECT, int(sys.argv[2]))
+            spent_us, written = struct.unpack_from("<II", data)
+            print("aktivní profil %d, %d us, zapsáno do flash %d B" % (active, spent_us, written))
+        elif len(sys.argv) == 3 and sys.argv[1] == "store":
+            active, data = command(device, STORE, int(sys.argv[2]))
+            (spent_us,) = struct.unpack_from("<I", data)
+            print("snímek pořízen za %d us, čeká na zápis" % spent_us)
+            while True:  # zápis proběhne, až se nepíše
+                time.sleep(0.2)
+                active, data = command(device, INFO)
+                if data[6] == 0:
+                    break
+            store_us, written = struct.unpack_from("<II", data, 7)
+            print("banka zapsána: %d us zablokované flash, %d B" % (store_us, written))
+        else:
+            active, data = command(device, INFO)
+            count, valid = data[0], data[1]
+            (last_us,) = struct.unpack_from("<I", data, 2)
+            banks = ", ".join(str(i) for i in range(count) if valid & (1 << i))
+            print("aktivní profil %d z %d, platné: %s, poslední přepnutí %d us" % (active, count, banks, last_us))
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,51 @@
+#!/usr/bin/env python3
+"""Zaplnění zásobníků a rozpočty statické RAM přes raw HID (příkaz 0x44).
+
+    ram_report.py    high-water marky zásobníků obou jader a RAM podle podsystémů
+"""
+
+import struct
+
+from layer_switch import REPORT_SIZE, open_device
+
+RAW_HID_MEMORY = 0x44
+STACKS, BUDGET = range(2)
+
+STACK_NAMES = ["jádro 0 MSP (přerušení)", "jádro 0 PSP (hlavní smyčka)", "jádro 1 MSP", "jádro 1 PSP"]
+SUBSYSTEMS = ["OLED", "haptika", "keymapa", "VIA", "buffery"]
+
+
+def command(device, op):
+    device.write(b"\0" + bytes([RAW_HID_MEMORY, op]).ljust(REPORT_SIZE, b"\0"))
+    while True:
+        reply = bytes(device.read(REPORT_SIZE, 2000))
+        if not reply:
+            raise TimeoutError("bez odpovědi")
+        if reply[0] == RAW_HID_MEMORY and reply[1] == op:
+            if reply[2] != 0:
+                raise ValueError("neplatný podpříkaz")
+            return reply[3], reply[4:]
+
+
+def main():
+    device = open_device()
+    try:
+        count, data = command(device, STACKS)
+        for i in range(count):
+            size, used = struct.unpack_from("<HH", data, i * 4)
+            name = STACK_NAMES[i] if i < len(STACK_NAMES) else "zásobník %d" % i
+            print("%-28s %5d / %5d B (%3d %%)" % (name, used, size, used * 100 // size if size else 0))
+
+        count, data = command(device, BUDGET)
+        for i in range(count):
+            used, budget = struct.unpack_from("<HH", data, i * 4)
+            name = SUBSYSTEMS[i] if i < len(SUBSYSTEMS) else "podsystém %d" % i
+            print("%-28s %5d / %5d B" % (name, used, budget))
+        static_ram, free_ram = struct.unpack_from("<II", data, count * 4)
+        print("statická RAM celkem %d B, volná za ní %d B" % (static_ram, free_ram))
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()
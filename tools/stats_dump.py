@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""Čítače a časy modulů firmwaru přes raw HID (příkaz 0x45).
+
+    stats_dump.py               všechny zdroje, které sestavení obsahuje
+    stats_dump.py oled_i2c ...  jen vybrané zdroje (jména viz SOURCES)
+"""
+
+import struct
+import sys
+
+from layer_switch import REPORT_SIZE, open_device
+
+RAW_HID_STATS = 0x45
+HEADER = 5
+
+# (jméno, formát struktury včetně zarovnání ARM, pole) v pořadí enum stats_sources
+SOURCES = [
+    ("report_coalesce", "<IIH2xIIIIIIII", ["reports_sent", "reports_merged", "reports_per_second", "latency_min_us", "latency_max_us",
+                                           "latency_sum_us", "latency_count", "first_report_us", "last_report_us", "reports_queued",
+                                           "reports_dropped"]),
+    ("idle_sleep", "<QIIII", ["idle_us", "sleeps", "key_wakeups", "wake_latency_last_us", "wake_latency_max_us"]),
+    ("boot_stage", "<III", ["hid_ready_us", "first_report_us", "first_oled_frame_us"]),
+    ("oled_prefetch", "<IIIIIIIII", ["hits", "misses", "decodes", "latency_hit_last_us", "latency_hit_sum_us", "latency_hit_count",
+                                     "latency_miss_last_us", "latency_miss_sum_us", "latency_miss_count"]),
+    ("oled_text", "<III", ["glyphs_drawn", "full_redraw_us", "field_us"]),
+    ("oled_gray", "<IIIH2xII", ["planes_shown", "missed_slots", "pages_sent", "bus_permille", "task_last_us", "task_max_us"]),
+    ("oled_i2c", "<IIIIIIIIII", ["clock_hz", "transfers", "bytes", "command_transfers", "errors", "timeouts", "recoveries", "fallbacks",
+                                 "last_page_us", "max_page_us"]),
+    ("matrix_sampler", "<IIIIIIII", ["samples", "snapshots", "overflows", "held_changes", "late_alarms", "isr_max_us",
+                                     "latency_last_us", "latency_max_us"]),
+    ("oled_saver", "<IIIII", ["activations", "commands", "bytes", "bytes_last_minute", "redraws"]),
+    ("event_bus", "<IIIH2xIBB2x", ["published", "callbacks", "dropped", "callbacks_per_second", "ticks_per_second", "max_queued",
+                                   "subscribe_failed"]),
+    ("turbo_repeat", "<IIH2x", ["repeats", "late_max_ms", "last_interval_ms"]),
+    ("oled_anim", "<IIIII", ["animations", "ticks", "last_tick_us", "max_tick_us", "over_budget"]),
+    ("oled_fb", "<IIIII", ["commits", "empty_commits", "pages_sent", "last_flush_us", "last_sent_us"]),
+    ("oled_legend", "<IIII", ["frames", "cells_drawn", "keymap_reads", "via_edits"]),
+    ("key_heatmap", "<III", ["saves", "save_us", "events"]),
+    ("profile_bank", "<IIIIIII", ["switches", "last_switch_us", "max_switch_us", "last_switch_bytes", "stores", "last_store_us",
+                                  "last_store_bytes"]),
+    ("flash_store", "<IIII", ["sectors_erased", "pages_programmed", "last_erase_us", "last_program_us"]),
+    ("usb_suspend", "<IIIIII", ["suspends", "resumes", "resume_pixels_last_us", "resume_pixels_max_us", "resume_report_last_us",
+                                "resume_report_max_us"]),
+]
+
+
+def command(device, source, offset):
+    device.write(b"\0" + bytes([RAW_HID_STATS, source, offset]).ljust(REPORT_SIZE, b"\0"))
+    while True:
+        reply = bytes(device.read(REPORT_SIZE, 1000))
+        if not reply:
+            raise TimeoutError("bez odpovědi")
+        if reply[0] == RAW_HID_STATS and reply[1] == source and reply[4] == offset:
+            if reply[2] != 0:
+                raise ValueError("neznámý zdroj %d" % source)
+            return reply[3], reply[HEADER:]
+
+
+def read(device, source):
+    size, data = command(device, source, 0)
+    while len(data) < size:
+        _, chunk = command(device, source, len(data))
+        data += chunk
+    return data[:size]
+
+
+def main():
+    names = [name for name, _, _ in SOURCES]
+    wanted = sys.argv[1:] or names
+    for name in wanted:
+        if name not in names:
+            sys.exit("neznámý zdroj %s, známé: %s" % (name, ", ".join(names)))
+
+    device = open_device()
+    try:
+        for name in wanted:
+            source = names.index(name)
+            _, fmt, fields = SOURCES[source]
+            data = read(device, source)
+            if not data:
+                continue  # modul v sestavení není
+            if len(data) != struct.calcsize(fmt):
+                print("%s: %d B, nástroj čeká %d B (jiná verze firmwaru)" % (name, len(data), struct.calcsize(fmt)))
+                continue
+            print(name)
+            for field, value in zip(fields, struct.unpack(fmt, data)):
+                print("  %-24s %d" % (field, value))
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()
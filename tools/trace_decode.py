@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Dekodér binárního trasování macropadu (raw HID příkaz 0x42).
+
+    trace_decode.py            průběžně vyčítá záznamy a vypisuje je jako text
+    trace_decode.py --table    vypíše tabulku ID -> formát vygenerovanou z trace_events.h
+
+Tabulka se generuje při každém spuštění z keymaps/via/trace_events.h, takže musí
+odpovídat zdrojům, ze kterých byl přeložený firmware. Firmware musí mít
+TRACE_LEVEL jiný než TRACE_OFF (config.h).
+"""
+
+import os
+import re
+import struct
+import sys
+import time
+
+RAW_HID_TRACE = 0x42
+RECORD = struct.Struct("<IBII")  # čas µs, ID, a, b (13 B, bez zarovnání)
+EVENTS_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "keymaps", "via", "trace_events.h")
+EVENT_RE = re.compile(r'^TRACE_EVENT\((\w+),\s*(\w+),\s*"((?:[^"\\]|\\.)*)"\)', re.M)
+
+
+def load_table(path=EVENTS_H):
+    with open(path, encoding="utf-8") as f:
+        return [(name, level, fmt) for name, level, fmt in EVENT_RE.findall(f.read())]
+
+
+def decode(table, record):
+    time_us, event_id, a, b = record
+    if event_id >= len(table):
+        return "%12.6f  ? id %d (%d, %d)" % (time_us / 1e6, event_id, a, b)
+    name, _, fmt = table[event_id]
+    return "%12.6f  %-14s %s" % (time_us / 1e6, name, fmt.format(a, b))
+
+
+def main():
+    table = load_table()
+
+    if sys.argv[1:] == ["--table"]:
+        for event_id, (name, level, fmt) in enumerate(table):
+            print("%3d  %-14s %-14s %s" % (event_id, name, level, fmt))
+        return
+
+    from layer_switch import REPORT_SIZE, open_device  # hidapi jen pro čtení ze zařízení
+
+    device = open_device()
+    try:
+        while True:
+            device.write(b"\0" + bytes([RAW_HID_TRACE]).ljust(REPORT_SIZE, b"\0"))
+            reply = bytes(device.read(REPORT_SIZE, 1000))
+            if not reply or reply[0] != RAW_HID_TRACE:
+                continue
+
+            count = reply[1]
+            (dropped,) = struct.unpack_from("<H", reply, 2)
+            if dropped:
+                print("... %d záznamů ztraceno (přetečení bufferu)" % dropped)
+            for i in range(count):
+                print(decode(table, RECORD.unpack_from(reply, 4 + i * RECORD.size)))
+
+            if count == 0:
+                time.sleep(0.02)  # prázdný buffer, nevytěžovat USB
+    except KeyboardInterrupt:
+        pass
+    finally:
+        device.close()
+
+
+if __name__ == "__main__":
+    main()